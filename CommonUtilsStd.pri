@@ -0,0 +1,14 @@
+# Qt free build of Util::FileSystem and Util::String (util_std.h), needs C++17
+# A project using only this one can drop Qt with: QT -= core gui
+
+INCLUDEPATH+=$$PWD
+DEPENDPATH+=$$PWD
+
+CONFIG += c++17
+unix: LIBS += -lpthread
+
+SOURCES += \
+    $$PWD/util_std.cpp
+
+HEADERS  += \
+    $$PWD/util_std.h
@@ -0,0 +1,23 @@
+#-------------------------------------------------
+#
+# CommonUtils benchmarks (QTestLib)
+#
+# Machine readable results, e.g.:
+# ./CommonUtilsBenchmarks -o results.xml,xml
+# ./CommonUtilsBenchmarks -o results.csv,csv
+#
+#-------------------------------------------------
+
+QT       += core testlib
+QT       -= gui
+
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TARGET = CommonUtilsBenchmarks
+TEMPLATE = app
+
+include(../CommonUtils.pri)
+
+SOURCES += \
+    util_benchmark.cpp
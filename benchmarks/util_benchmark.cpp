@@ -0,0 +1,350 @@
+/**
+ * Copyright (C) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * This library is distributed under the MIT License. See notice at the end
+ * of this file.
+ *
+ */
+
+#include "util.h"
+
+#include <QtTest>
+#include <QTemporaryDir>
+
+// Benchmarks for the FileSystem, String and Validation functions at several sizes
+// The folder trees and string corpora are generated, so results are comparable between releases
+class UtilBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void copyDir_data();
+    void copyDir();
+
+    void rmDir_data();
+    void rmDir();
+
+    void getFolderFilesByWildcard_data();
+    void getFolderFilesByWildcard();
+
+    void filterFilesByWildcard_data();
+    void filterFilesByWildcard();
+
+    void fileHash_data();
+    void fileHash();
+
+    void substring_data();
+    void substring();
+
+    void splitView_data();
+    void splitView();
+
+    void fullTrim_data();
+    void fullTrim();
+
+    void checkEmptySpaces_data();
+    void checkEmptySpaces();
+
+    void checkIfIntegers_data();
+    void checkIfIntegers();
+
+    void checkIfDoubles_data();
+    void checkIfDoubles();
+
+private:
+    // Creates fileCount files (filesPerFolder in each folder, alternating .xml and .txt) under rootPath, false on error
+    static bool createTree(const QString &rootPath, const int fileCount, const int fileSize);
+    static QStringList createPathList(const int pathCount);
+    static QString createText(const int size, const QString &separator);
+    static QStringList createNumbers(const int count, const bool isDouble);
+    static void addSizeRows();
+
+    QTemporaryDir workDir;
+    QHash<int, QString> trees; // file count -> tree path
+};
+
+namespace {
+
+const int filesPerFolder = 50;
+const int treeSizes[] = {100, 1000, 10000};
+const int listSizes[] = {1000, 100000, 1000000};
+
+}
+
+bool UtilBenchmark::createTree(const QString &rootPath, const int fileCount, const int fileSize){
+    const QByteArray contents(fileSize, 'x');
+
+    for(int i = 0; i < fileCount; i++){
+        const QString folderPath = rootPath + QString("/folder%1/sub%2").arg(i / (filesPerFolder * 10)).arg(i / filesPerFolder);
+
+        if(i % filesPerFolder == 0 && !QDir().mkpath(folderPath)){
+            return false;
+        }
+
+        QFile file(folderPath + QString("/file%1.%2").arg(i).arg(i % 2 == 0 ? "xml" : "txt"));
+
+        if(!file.open(QFile::WriteOnly) || file.write(contents) != contents.size()){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QStringList UtilBenchmark::createPathList(const int pathCount){
+    QStringList paths;
+    paths.reserve(pathCount);
+
+    for(int i = 0; i < pathCount; i++){
+        paths << QString("/home/user/project/folder%1/myXmls%2/file%3.%4").arg(i % 97).arg(i % 3).arg(i).arg(i % 2 == 0 ? "xml" : "txt");
+    }
+
+    return paths;
+}
+
+QString UtilBenchmark::createText(const int size, const QString &separator){
+    QString text;
+    text.reserve(size + 16);
+
+    for(int i = 0; text.size() < size; i++){
+        text += QString("field %1\t value%2").arg(i).arg(i % 7) + separator;
+    }
+
+    return text;
+}
+
+QStringList UtilBenchmark::createNumbers(const int count, const bool isDouble){
+    QStringList numbers;
+    numbers.reserve(count);
+
+    for(int i = 0; i < count; i++){
+        numbers << (isDouble ? QString::number(i * 1.25 - 1000, 'f', 2) : QString::number(i - 1000));
+    }
+
+    return numbers;
+}
+
+void UtilBenchmark::addSizeRows(){
+    QTest::addColumn<int>("size");
+
+    for(const int currSize : listSizes){
+        QTest::newRow(qPrintable(QString::number(currSize))) << currSize;
+    }
+}
+
+void UtilBenchmark::initTestCase(){
+    QVERIFY(workDir.isValid());
+
+    for(const int currSize : treeSizes){
+        const QString treePath = workDir.path() + "/tree" + QString::number(currSize);
+        QVERIFY(createTree(treePath, currSize, 4096));
+        trees.insert(currSize, treePath);
+    }
+}
+
+void UtilBenchmark::copyDir_data(){
+    QTest::addColumn<int>("fileCount");
+
+    for(const int currSize : treeSizes){
+        QTest::newRow(qPrintable(QString::number(currSize))) << currSize;
+    }
+}
+
+void UtilBenchmark::copyDir(){
+    QFETCH(int, fileCount);
+
+    const QString destinationPath = workDir.path() + "/copy" + QString::number(fileCount);
+    QVERIFY(QDir().mkpath(destinationPath));
+
+    QBENCHMARK_ONCE{
+        QVERIFY(Util::FileSystem::copyDir(trees.value(fileCount), destinationPath, true));
+    }
+
+    QVERIFY(Util::FileSystem::rmDir(destinationPath));
+}
+
+void UtilBenchmark::rmDir_data(){
+    copyDir_data();
+}
+
+void UtilBenchmark::rmDir(){
+    QFETCH(int, fileCount);
+
+    const QString destinationPath = workDir.path() + "/remove" + QString::number(fileCount);
+    QVERIFY(QDir().mkpath(destinationPath));
+    QVERIFY(Util::FileSystem::copyDir(trees.value(fileCount), destinationPath, true));
+
+    QBENCHMARK_ONCE{
+        QVERIFY(Util::FileSystem::rmDir(destinationPath));
+    }
+}
+
+void UtilBenchmark::getFolderFilesByWildcard_data(){
+    QTest::addColumn<int>("fileCount");
+    QTest::addColumn<QString>("wildcard");
+
+    for(const int currSize : treeSizes){
+        QTest::newRow(qPrintable(QString::number(currSize) + " *.xml")) << currSize << "*.xml";
+        QTest::newRow(qPrintable(QString::number(currSize) + " /sub1/*.xml")) << currSize << "/sub1/*.xml";
+    }
+}
+
+void UtilBenchmark::getFolderFilesByWildcard(){
+    QFETCH(int, fileCount);
+    QFETCH(QString, wildcard);
+
+    QBENCHMARK{
+        Util::FileSystem::getFolderFilesByWildcard(trees.value(fileCount), wildcard, true);
+    }
+}
+
+void UtilBenchmark::filterFilesByWildcard_data(){
+    addSizeRows();
+}
+
+void UtilBenchmark::filterFilesByWildcard(){
+    QFETCH(int, size);
+
+    const QStringList paths = createPathList(size);
+
+    QBENCHMARK{
+        Util::FileSystem::filterFilesByWildcard(paths, "/myXmls1/*.xml");
+    }
+}
+
+void UtilBenchmark::fileHash_data(){
+    QTest::addColumn<int>("fileSize");
+
+    QTest::newRow("4KiB") << 4 * 1024;
+    QTest::newRow("1MiB") << 1024 * 1024;
+    QTest::newRow("64MiB") << 64 * 1024 * 1024;
+}
+
+void UtilBenchmark::fileHash(){
+    QFETCH(int, fileSize);
+
+    const QString filePath = workDir.path() + "/hash" + QString::number(fileSize);
+    QFile file(filePath);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(QByteArray(fileSize, 'x'));
+    file.close();
+
+    QBENCHMARK{
+        Util::FileSystem::fileHash(filePath, QCryptographicHash::Sha1);
+    }
+}
+
+void UtilBenchmark::substring_data(){
+    addSizeRows();
+}
+
+void UtilBenchmark::substring(){
+    QFETCH(int, size);
+
+    const QString text = createText(size, ";");
+
+    QBENCHMARK{
+        Util::String::substring(text, ";");
+    }
+}
+
+void UtilBenchmark::splitView_data(){
+    addSizeRows();
+}
+
+void UtilBenchmark::splitView(){
+    QFETCH(int, size);
+
+    const QString text = createText(size, ";");
+
+    QBENCHMARK{
+        Util::String::splitView(text, QStringLiteral(";"));
+    }
+}
+
+void UtilBenchmark::fullTrim_data(){
+    addSizeRows();
+}
+
+void UtilBenchmark::fullTrim(){
+    QFETCH(int, size);
+
+    const QString text = createText(size, "\n");
+
+    QBENCHMARK{
+        Util::String::fullTrim(text);
+    }
+}
+
+void UtilBenchmark::checkEmptySpaces_data(){
+    addSizeRows();
+}
+
+void UtilBenchmark::checkEmptySpaces(){
+    QFETCH(int, size);
+
+    const QStringList values = createNumbers(size, false);
+
+    QBENCHMARK{
+        Util::Validation::checkEmptySpaces(values);
+    }
+}
+
+void UtilBenchmark::checkIfIntegers_data(){
+    addSizeRows();
+}
+
+void UtilBenchmark::checkIfIntegers(){
+    QFETCH(int, size);
+
+    const QStringList values = createNumbers(size, false);
+
+    QBENCHMARK{
+        Util::Validation::checkIfIntegers(values);
+    }
+}
+
+void UtilBenchmark::checkIfDoubles_data(){
+    addSizeRows();
+}
+
+void UtilBenchmark::checkIfDoubles(){
+    QFETCH(int, size);
+
+    const QStringList values = createNumbers(size, true);
+
+    QBENCHMARK{
+        Util::Validation::checkIfDoubles(values);
+    }
+}
+
+QTEST_GUILESS_MAIN(UtilBenchmark)
+
+#include "util_benchmark.moc"
+
+/**
+ * Copyright (c) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# CommonUtils tests (QTestLib)
+#
+# The optimized functions are checked against the
+# implementations they replaced or against QLocale / QString
+# (and the Qt free ones in util_std against the Qt ones)
+#
+#-------------------------------------------------
+
+QT       += core testlib
+QT       -= gui
+
+CONFIG   += console testcase
+CONFIG   -= app_bundle
+
+TARGET = CommonUtilsTests
+TEMPLATE = app
+
+include(../CommonUtils.pri)
+include(../CommonUtilsStd.pri)
+
+SOURCES += \
+    util_test.cpp
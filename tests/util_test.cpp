@@ -0,0 +1,1110 @@
+/**
+ * Copyright (C) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * This library is distributed under the MIT License. See notice at the end
+ * of this file.
+ *
+ */
+
+#include "util.h"
+#include "util_std.h"
+
+#include <QtTest>
+#include <QRegularExpression>
+#include <QLocale>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <random>
+
+// Checks the optimized functions against the implementations they replaced (kept here as references)
+// Random inputs use fixed seeds, so a failure can always be reproduced
+class UtilTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void filterFilesByWildcard_data();
+    void filterFilesByWildcard();
+    void filterFilesByWildcardRandom();
+    void wildcardMatcherMatchIndex();
+
+    void indexOfRandom();
+    void indexOfOutOfRange_data();
+    void indexOfOutOfRange();
+    void indexOfBackwardRandom();
+
+    void multiStringSearcher_data();
+    void multiStringSearcher();
+    void multiStringSearcherRandom();
+
+    void parseDoubleColumn_data();
+    void parseDoubleColumn();
+    void parseDoubleColumnRandom();
+    void parseIntegerColumn_data();
+    void parseIntegerColumn();
+
+    void fileHashCacheRemovedEntries();
+
+    void stdWildcardMatcher_data();
+    void stdWildcardMatcher();
+    void stdWildcardMatcherRandom();
+    void stdDataHash_data();
+    void stdDataHash();
+    void stdDataHashRandom();
+
+    void splitView_data();
+    void splitView();
+    void splitViewRandom();
+
+    void fullTrim_data();
+    void fullTrim();
+    void fullTrimRandom();
+
+    void commandLineBuilder_data();
+    void commandLineBuilder();
+    void commandLineBuilderRandom();
+
+    void numberValidation_data();
+    void numberValidation();
+    void numberValidationRandom();
+    void firstInvalidParallel();
+
+    void fileHashCacheRecentlyModified();
+
+    void directoryHashTree();
+
+private:
+    static QString surrogatePair();
+};
+
+namespace {
+
+// filterFilesByWildcard before WildcardMatcher (regular expression based)
+QStringList oldFilterFilesByWildcard(const QStringList &filePaths, const QString &wildcard){
+    QStringList resultFiles;
+    QString formattedWildcard;
+
+    if(wildcard.trimmed().isEmpty()){
+        return resultFiles;
+    }
+
+    formattedWildcard = Util::FileSystem::normalizePath(wildcard);
+    formattedWildcard = QRegularExpression::escape(formattedWildcard);
+    formattedWildcard.replace("\\*",".*");
+    formattedWildcard.replace("\\?",".");
+
+    if(!formattedWildcard.startsWith("\\/") && !formattedWildcard.startsWith(".*") && !formattedWildcard.startsWith(".")){
+        formattedWildcard = "\\/" + formattedWildcard;
+    }
+
+    if(formattedWildcard.startsWith("\\/")){
+        formattedWildcard = ".*" + formattedWildcard;
+    }
+
+    formattedWildcard = "^" + formattedWildcard + "$";
+
+    QRegularExpression regex(formattedWildcard);
+
+    for(const QString &currentFile : filePaths){
+        if(regex.match(currentFile).hasMatch()){
+            resultFiles << currentFile;
+        }
+    }
+
+    return resultFiles;
+}
+
+typedef QPair<int, int> SearchMatch; // (end position, keyword index)
+
+// Every occurrence of every keyword, checked at each end position
+QVector<SearchMatch> bruteForceMatches(const QString &text, const QStringList &keywords, const Qt::CaseSensitivity cs){
+    QVector<SearchMatch> matches;
+
+    for(int end = 1; end <= text.size(); end++){
+        for(int i = 0; i < keywords.size(); i++){
+            const int start = end - keywords.at(i).size();
+
+            if(!keywords.at(i).isEmpty() && start >= 0 && text.midRef(start, keywords.at(i).size()).compare(keywords.at(i), cs) == 0){
+                matches << SearchMatch(end, i);
+            }
+        }
+    }
+
+    return matches;
+}
+
+QVector<SearchMatch> searcherMatches(const QString &text, const QStringList &keywords, const Qt::CaseSensitivity cs){
+    QVector<SearchMatch> matches;
+
+    for(const Util::String::MultiStringSearcher::Match &currMatch : Util::String::MultiStringSearcher(keywords, cs).findAll(text)){
+        matches << SearchMatch(currMatch.position + keywords.at(currMatch.keywordIndex).size(), currMatch.keywordIndex);
+    }
+
+    // the order of the matches ending at the same position isn't specified
+    std::sort(matches.begin(), matches.end());
+
+    return matches;
+}
+
+// The cell as QLocale::c() reads it, with ',' taken as the decimal separator too
+double localeDouble(const QString &cell, bool &isValid){
+    QString normalized = cell;
+    normalized.replace(',', '.');
+    return QLocale::c().toDouble(normalized, &isValid);
+}
+
+// Exact comparison, including the sign of zero (QCOMPARE on doubles is fuzzy)
+quint64 doubleBits(const double value){
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Index of the first cell parsed differently from QLocale::c(), -1 if none (cells.size() if only invalidCount differs)
+int firstDoubleMismatch(const QStringList &cells){
+    const Util::Validation::DoubleColumn column = Util::Validation::parseDoubleColumn(cells);
+    int invalidCount = 0;
+
+    for(int i = 0; i < cells.size(); i++){
+        bool isValid;
+        const double expected = localeDouble(cells.at(i), isValid);
+        const double value = column.values[size_t(i)];
+
+        if(column.validity.testBit(i) != isValid || (isValid && doubleBits(value) != doubleBits(expected) && !(qIsNaN(value) && qIsNaN(expected)))){
+            return i;
+        }
+
+        invalidCount += isValid ? 0 : 1;
+    }
+
+    return column.invalidCount == invalidCount ? -1 : cells.size();
+}
+
+QString randomString(std::mt19937 &generator, const QStringList &alphabet, const int maxSize){
+    QString result;
+    const int size = std::uniform_int_distribution<int>(0, maxSize)(generator);
+
+    for(int i = 0; i < size; i++){
+        result += alphabet.at(std::uniform_int_distribution<int>(0, alphabet.size() - 1)(generator));
+    }
+
+    return result;
+}
+
+}
+
+QString UtilTest::surrogatePair(){
+    return QString::fromUcs4(U"\U0001F600");
+}
+
+void UtilTest::filterFilesByWildcard_data(){
+    QTest::addColumn<QString>("wildcard");
+    QTest::addColumn<QStringList>("filePaths");
+
+    const QString emoji = surrogatePair();
+    const QStringList paths = QStringList() << "/a/file.xml" << "/a/b/file.xml" << "/a/myXmls/file1.xml" << "/a/myXmls/file12.xml"
+                                            << "/a/myXmls/" << "/a/myXmls" << "/a/file.xml\n" << "/a/file.xml\n\n" << "/a/fi\nle.xml"
+                                            << "file.xml" << "/a/" + emoji + ".xml" << "/a/" + emoji + emoji + ".xml" << "/a/x.xml"
+                                            << "/a/b/c/d.txt" << "" << "/" << "//";
+
+    QTest::newRow("star") << "*.xml" << paths;
+    QTest::newRow("star runs") << "**.xml" << paths;
+    QTest::newRow("star and any runs") << "*?*?.xml" << paths;
+    QTest::newRow("any run") << "/a/???.xml" << paths;
+    QTest::newRow("only stars") << "***" << paths;
+    QTest::newRow("folder") << "/myXmls/*.xml" << paths;
+    QTest::newRow("backslash folder") << "myXmls\\file?.xml" << paths;
+    QTest::newRow("trailing separator") << "/myXmls/" << paths;
+    QTest::newRow("trailing separators") << "a//" << paths;
+    QTest::newRow("only separator") << "/" << paths;
+    QTest::newRow("no wildcard") << "file.xml" << paths;
+    QTest::newRow("starts with any") << "?file.xml" << paths;
+    QTest::newRow("starts with dot") << ".xml" << paths;
+    QTest::newRow("regex chars") << "(a)+[b].xml" << (QStringList() << "/(a)+[b].xml" << "/aa[b].xml" << "/(a)+b.xml");
+    QTest::newRow("surrogate pair any") << "/a/?.xml" << paths;
+    QTest::newRow("surrogate pairs any") << "/a/??.xml" << paths;
+    QTest::newRow("surrogate pair literal") << "/a/" + emoji + "*" << paths;
+    QTest::newRow("blank") << "  " << paths;
+}
+
+void UtilTest::filterFilesByWildcard(){
+    QFETCH(QString, wildcard);
+    QFETCH(QStringList, filePaths);
+
+    QCOMPARE(Util::FileSystem::filterFilesByWildcard(filePaths, wildcard), oldFilterFilesByWildcard(filePaths, wildcard));
+}
+
+void UtilTest::filterFilesByWildcardRandom(){
+    std::mt19937 generator(5);
+    const QString emoji = surrogatePair();
+    const QStringList wildcardAlphabet = QStringList() << "a" << "b" << "." << "/" << "\\" << "*" << "**" << "?" << "\n" << emoji;
+    const QStringList pathAlphabet = QStringList() << "a" << "b" << "." << "/" << "\n" << emoji;
+
+    for(int i = 0; i < 2000; i++){
+        const QString wildcard = randomString(generator, wildcardAlphabet, 6);
+        QStringList filePaths;
+
+        for(int j = 0; j < 20; j++){
+            filePaths << randomString(generator, pathAlphabet, 10);
+        }
+
+        QCOMPARE(Util::FileSystem::filterFilesByWildcard(filePaths, wildcard), oldFilterFilesByWildcard(filePaths, wildcard));
+    }
+}
+
+// The index of the first wildcard the old implementation matches
+void UtilTest::wildcardMatcherMatchIndex(){
+    std::mt19937 generator(7);
+    const QStringList wildcardAlphabet = QStringList() << "a" << "b" << "/" << "*" << "?";
+    const QStringList pathAlphabet = QStringList() << "a" << "b" << "/";
+
+    for(int i = 0; i < 500; i++){
+        QStringList wildcards;
+
+        // enough positions to need several state words
+        for(int j = 0; j < 30; j++){
+            wildcards << randomString(generator, wildcardAlphabet, 5);
+        }
+
+        const Util::FileSystem::WildcardMatcher matcher(wildcards);
+
+        for(int j = 0; j < 20; j++){
+            const QString filePath = randomString(generator, pathAlphabet, 8);
+            int expectedIndex = -1;
+
+            for(int k = 0; k < wildcards.size() && expectedIndex == -1; k++){
+                if(!oldFilterFilesByWildcard(QStringList() << filePath, wildcards.at(k)).isEmpty()){
+                    expectedIndex = k;
+                }
+            }
+
+            QCOMPARE(matcher.matchIndex(filePath), expectedIndex);
+        }
+    }
+}
+
+// Same results as QString for every from inside the text, short (SIMD scan) and long (Horspool) needles
+// The alphabet has case pairs, a char with two lowercase forms (sigma) and chars sharing the low byte used by the skip table
+void UtilTest::indexOfRandom(){
+    std::mt19937 generator(11);
+    const QStringList alphabet = QStringList() << "a" << "A" << "b" << QString(QChar(0x0161)) << QString(QChar(0x0160)) << QString(QChar(0x03A3))
+                                               << QString(QChar(0x03C3)) << QString(QChar(0x03C2)) << QString(QChar(0x00E9)) << QString(QChar(0x00C9));
+
+    for(int i = 0; i < 5000; i++){
+        const QString text = randomString(generator, alphabet, 40);
+        QString toSearch = randomString(generator, alphabet, 8);
+
+        if(toSearch.isEmpty()){
+            toSearch = "a";
+        }
+
+        for(const Qt::CaseSensitivity cs : {Qt::CaseSensitive, Qt::CaseInsensitive}){
+            for(int from = -text.size(); from < text.size(); from++){
+                QCOMPARE(Util::String::indexOf(text, toSearch, from, cs), text.indexOf(toSearch, from, cs));
+                QCOMPARE(Util::String::lastIndexOf(text, toSearch, from, cs), text.lastIndexOf(toSearch, from, cs));
+            }
+        }
+    }
+}
+
+// QString itself changed here between versions, so the expected results are explicit (searching in "abcabc")
+void UtilTest::indexOfOutOfRange_data(){
+    QTest::addColumn<QString>("toSearch");
+    QTest::addColumn<bool>("isCaseSensitive");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("expectedIndexOf");
+    QTest::addColumn<int>("expectedLastIndexOf");
+
+    QTest::newRow("past the end") << "abc" << true << 7 << -1 << 3;
+    QTest::newRow("way past the end") << "abc" << true << 100 << -1 << 3;
+    QTest::newRow("at the end") << "abc" << true << 6 << -1 << 3;
+    QTest::newRow("last char") << "abc" << true << 5 << -1 << 3;
+    QTest::newRow("before the start") << "abc" << true << -7 << 0 << -1;
+    QTest::newRow("way before the start") << "abc" << true << -100 << 0 << -1;
+    QTest::newRow("whole text past the end") << "ABCABC" << false << 7 << -1 << 0;
+    QTest::newRow("whole text before the start") << "ABCABC" << false << -7 << 0 << -1;
+    QTest::newRow("longer than the text") << "abcabca" << true << 0 << -1 << -1;
+    QTest::newRow("char past the end") << "C" << false << 6 << -1 << 5;
+    QTest::newRow("char before the start") << "C" << false << -100 << 2 << -1;
+}
+
+void UtilTest::indexOfOutOfRange(){
+    QFETCH(QString, toSearch);
+    QFETCH(bool, isCaseSensitive);
+    QFETCH(int, from);
+    QFETCH(int, expectedIndexOf);
+    QFETCH(int, expectedLastIndexOf);
+
+    const Qt::CaseSensitivity cs = isCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+    QCOMPARE(Util::String::indexOf(QString("abcabc"), toSearch, from, cs), expectedIndexOf);
+    QCOMPARE(Util::String::lastIndexOf(QString("abcabc"), toSearch, from, cs), expectedLastIndexOf);
+}
+
+// The match must end at or before from, -1 or a from out of the text is the end
+void UtilTest::indexOfBackwardRandom(){
+    std::mt19937 generator(13);
+    const QStringList alphabet = QStringList() << "a" << "b" << "c" << QString(QChar(0x0161));
+
+    for(int i = 0; i < 5000; i++){
+        const QString text = randomString(generator, alphabet, 30);
+        QString toSearch = randomString(generator, alphabet, 6);
+
+        if(toSearch.isEmpty()){
+            toSearch = "b";
+        }
+
+        for(int from = -2; from <= text.size() + 2; from++){
+            const int end = from < 0 || from > text.size() ? text.size() : from;
+            const int expected = end - toSearch.size() < 0 ? -1 : text.lastIndexOf(toSearch, end - toSearch.size());
+
+            QCOMPARE(Util::String::indexOfBackward(text, toSearch, from), expected);
+        }
+    }
+}
+
+void UtilTest::multiStringSearcher_data(){
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QStringList>("keywords");
+    QTest::addColumn<bool>("isCaseSensitive");
+
+    QTest::newRow("overlapping") << "ushers" << (QStringList() << "he" << "she" << "his" << "hers") << true;
+    QTest::newRow("nested runs") << "aaaaa" << (QStringList() << "a" << "aa" << "aaa") << true;
+    QTest::newRow("suffixes") << "abcabcd" << (QStringList() << "abcd" << "bcd" << "cd" << "d" << "abc") << true;
+    QTest::newRow("fail chains") << "abababcab" << (QStringList() << "abab" << "babc" << "bc" << "cab") << true;
+    QTest::newRow("case insensitive") << "UsHeRs" << (QStringList() << "he" << "SHE" << "hers") << false;
+    QTest::newRow("case sensitive") << "UsHeRs" << (QStringList() << "he" << "SHE" << "HeRs") << true;
+    QTest::newRow("empty keyword") << "abc" << (QStringList() << "" << "b") << true;
+    QTest::newRow("no keywords") << "abc" << QStringList() << true;
+    QTest::newRow("empty text") << "" << (QStringList() << "a") << true;
+    QTest::newRow("non ascii") << QString::fromUtf8("ΣσςΣ") << (QStringList() << QString::fromUtf8("σσ") << QString::fromUtf8("Σ")) << false;
+}
+
+void UtilTest::multiStringSearcher(){
+    QFETCH(QString, text);
+    QFETCH(QStringList, keywords);
+    QFETCH(bool, isCaseSensitive);
+
+    const Qt::CaseSensitivity cs = isCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    const QVector<SearchMatch> expected = bruteForceMatches(text, keywords, cs);
+
+    QCOMPARE(searcherMatches(text, keywords, cs), expected);
+    QCOMPARE(Util::String::MultiStringSearcher(keywords, cs).containsAny(text), !expected.isEmpty());
+}
+
+void UtilTest::multiStringSearcherRandom(){
+    std::mt19937 generator(17);
+    const QStringList keywordAlphabet = QStringList() << "a" << "b" << "c" << QString(QChar(0x0161));
+    const QStringList textAlphabet = QStringList() << "a" << "b" << "c" << "A" << "B" << QString(QChar(0x0161)) << QString(QChar(0x0160));
+
+    for(int i = 0; i < 2000; i++){
+        QStringList keywords;
+
+        for(int j = std::uniform_int_distribution<int>(1, 8)(generator); j > 0; j--){
+            keywords << randomString(generator, keywordAlphabet, 4);
+        }
+
+        keywords.removeDuplicates(); // lowercase only, so also different without case
+
+        const QString text = randomString(generator, textAlphabet, 40);
+
+        for(const Qt::CaseSensitivity cs : {Qt::CaseSensitive, Qt::CaseInsensitive}){
+            QCOMPARE(searcherMatches(text, keywords, cs), bruteForceMatches(text, keywords, cs));
+        }
+    }
+}
+
+// Each cell must be read as QLocale::c() reads it, on both sides of the fast path limits
+// (mantissas of 2^53 and 19 / 20 digits, powers of ten of 22 / 23)
+void UtilTest::parseDoubleColumn_data(){
+    QTest::addColumn<QStringList>("cells");
+
+    QTest::newRow("signs") << (QStringList() << "+5" << "-5" << "-0" << "+0" << "0" << "--5" << "+-5" << "+" << "-");
+    QTest::newRow("decimal separators") << (QStringList() << "1." << ".5" << "-.5" << "1,5" << "1," << ",5" << "." << "," << "1.2.3" << "1,2,3");
+    QTest::newRow("mantissa limits") << (QStringList() << "9007199254740992" << "9007199254740993" << "900719925474099.3"
+                                        << "1234567890123456789" << "12345678901234567890" << "0.1234567890123456789"
+                                        << "00000000000000000000000001" << "0.0000000000000000000000001" << "18446744073709551615");
+    QTest::newRow("exponent limits") << (QStringList() << "1e22" << "1e23" << "1e-22" << "1e-23" << "1.5e21" << "1.5e22" << "1.5e-21" << "1.5e-22"
+                                        << "123e20" << "123e-25" << "1E+5" << "1e-0" << "1e00022" << "1e99999" << "1e-99999" << "0e500");
+    QTest::newRow("malformed") << (QStringList() << "" << " 1" << "1 " << "1e" << "1e+" << "e5" << "1x" << "0x10" << "1d" << "1f");
+    QTest::newRow("special values") << (QStringList() << "inf" << "-inf" << "nan" << "Infinity");
+}
+
+void UtilTest::parseDoubleColumn(){
+    QFETCH(QStringList, cells);
+
+    const int mismatch = firstDoubleMismatch(cells);
+    QVERIFY2(mismatch == -1, qPrintable(cells.value(mismatch, "invalid count")));
+}
+
+void UtilTest::parseDoubleColumnRandom(){
+    std::mt19937 generator(19);
+    const QStringList signs = QStringList() << "" << "" << "-" << "+";
+    const QStringList digits = QStringList() << "0" << "1" << "2" << "3" << "4" << "5" << "6" << "7" << "8" << "9";
+    QStringList cells;
+
+    for(int i = 0; i < 20000; i++){
+        QString cell = randomString(generator, signs, 1) + randomString(generator, digits, 20);
+
+        if(generator() % 2 == 0){
+            cell += (generator() % 2 == 0 ? "." : ",") + randomString(generator, digits, 20);
+        }
+
+        if(generator() % 2 == 0){
+            cell += "e" + randomString(generator, signs, 1) + randomString(generator, digits, 2);
+        }
+
+        cells << cell;
+    }
+
+    const int mismatch = firstDoubleMismatch(cells);
+    QVERIFY2(mismatch == -1, qPrintable(cells.value(mismatch, "invalid count")));
+}
+
+// Same as QLocale::c().toLongLong, on both sides of the 18 digits the fast path takes
+void UtilTest::parseIntegerColumn_data(){
+    QTest::addColumn<QStringList>("cells");
+
+    QTest::newRow("signs") << (QStringList() << "+5" << "-5" << "-0" << "+0" << "0" << "--5" << "+" << "-");
+    QTest::newRow("digit limits") << (QStringList() << "123456789012345678" << "-123456789012345678" << "1234567890123456789"
+                                     << "9223372036854775807" << "9223372036854775808" << "-9223372036854775808" << "-9223372036854775809"
+                                     << "00000000000000000000001" << "99999999999999999999");
+    QTest::newRow("malformed") << (QStringList() << "" << " 5" << "5 " << "1.0" << "1,0" << "1e3" << "0x10" << "5a");
+}
+
+void UtilTest::parseIntegerColumn(){
+    QFETCH(QStringList, cells);
+
+    const Util::Validation::IntegerColumn column = Util::Validation::parseIntegerColumn(cells);
+
+    for(int i = 0; i < cells.size(); i++){
+        bool isValid;
+        const qint64 expected = QLocale::c().toLongLong(cells.at(i), &isValid);
+
+        QVERIFY2(column.validity.testBit(i) == isValid, qPrintable(cells.at(i)));
+
+        if(isValid){
+            QCOMPARE(column.values[size_t(i)], expected);
+        }
+    }
+}
+
+// Entries dropped by removeStaleEntries or clear must not come back from the file when saving
+void UtilTest::fileHashCacheRemovedEntries(){
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString cacheFilePath = tempDir.filePath("hashes.cache");
+    const QString firstFilePath = tempDir.filePath("first.txt");
+    const QString secondFilePath = tempDir.filePath("second.txt");
+
+    for(const QString &currPath : {firstFilePath, secondFilePath}){
+        QFile currFile(currPath);
+        QVERIFY(currFile.open(QFile::WriteOnly));
+        QVERIFY(currFile.write(currPath.toUtf8()) > 0);
+    }
+
+    // recently modified files aren't cached, and the change time can't be set back
+    QTest::qSleep(3100);
+
+    {
+        Util::FileSystem::FileHashCache cache(cacheFilePath);
+        QVERIFY(!cache.fileHash(firstFilePath, QCryptographicHash::Sha1).isEmpty());
+        QVERIFY(!cache.fileHash(secondFilePath, QCryptographicHash::Sha1).isEmpty());
+        QCOMPARE(cache.size(), 2);
+        QVERIFY(cache.save());
+    }
+
+    QVERIFY(QFile::remove(firstFilePath));
+
+    {
+        Util::FileSystem::FileHashCache cache(cacheFilePath);
+        QVERIFY(cache.load());
+        QCOMPARE(cache.size(), 2);
+        QCOMPARE(cache.removeStaleEntries(), 1);
+        QVERIFY(cache.save());
+        QCOMPARE(cache.size(), 1);
+    }
+
+    {
+        Util::FileSystem::FileHashCache cache(cacheFilePath);
+        QVERIFY(cache.load());
+        QCOMPARE(cache.size(), 1);
+        cache.clear();
+        QVERIFY(cache.save());
+        QCOMPARE(cache.size(), 0);
+    }
+
+    Util::FileSystem::FileHashCache cache(cacheFilePath);
+    QVERIFY(cache.load());
+    QCOMPARE(cache.size(), 0);
+}
+
+namespace {
+
+std::vector<std::string> toStdStrings(const QStringList &strings){
+    std::vector<std::string> result;
+
+    for(const QString &currString : strings){
+        result.push_back(currString.toStdString());
+    }
+
+    return result;
+}
+
+QStringList fromStdStrings(const std::vector<std::string> &strings){
+    QStringList result;
+
+    for(const std::string &currString : strings){
+        result << QString::fromStdString(currString);
+    }
+
+    return result;
+}
+
+}
+
+// The UTF-8 matcher on the same corpus as the Qt one
+void UtilTest::stdWildcardMatcher_data(){
+    filterFilesByWildcard_data();
+}
+
+void UtilTest::stdWildcardMatcher(){
+    QFETCH(QString, wildcard);
+    QFETCH(QStringList, filePaths);
+
+    const std::vector<std::string> stdResult = Util::Std::FileSystem::filterFilesByWildcard(toStdStrings(filePaths), wildcard.toStdString());
+    QCOMPARE(fromStdStrings(stdResult), Util::FileSystem::filterFilesByWildcard(filePaths, wildcard));
+}
+
+void UtilTest::stdWildcardMatcherRandom(){
+    std::mt19937 generator(25);
+    const QString emoji = surrogatePair();
+    const QStringList wildcardAlphabet = QStringList() << "a" << "b" << "." << "/" << "\\" << "*" << "?" << "\n" << QString(QChar(0xE9)) << emoji;
+    const QStringList pathAlphabet = QStringList() << "a" << "b" << "." << "/" << "\n" << QString(QChar(0xE9)) << emoji;
+
+    for(int i = 0; i < 2000; i++){
+        const QStringList wildcards = QStringList() << randomString(generator, wildcardAlphabet, 6) << randomString(generator, wildcardAlphabet, 6);
+        const Util::FileSystem::WildcardMatcher matcher(wildcards);
+        const Util::Std::FileSystem::WildcardMatcher stdMatcher(toStdStrings(wildcards));
+
+        for(int j = 0; j < 20; j++){
+            const QString filePath = randomString(generator, pathAlphabet, 10);
+            QVERIFY2(stdMatcher.matchIndex(filePath.toStdString()) == matcher.matchIndex(filePath), qPrintable(wildcards.join(" | ") + " : " + filePath));
+        }
+    }
+}
+
+// Known answers, around the 55 / 56 / 64 bytes where the padding takes one or two blocks
+void UtilTest::stdDataHash_data(){
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("md5");
+    QTest::addColumn<QByteArray>("sha1");
+    QTest::addColumn<QByteArray>("sha256");
+
+    QTest::newRow("empty") << QByteArray() << QByteArray("d41d8cd98f00b204e9800998ecf8427e")
+                           << QByteArray("da39a3ee5e6b4b0d3255bfef95601890afd80709")
+                           << QByteArray("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    QTest::newRow("abc") << QByteArray("abc") << QByteArray("900150983cd24fb0d6963f7d28e17f72")
+                         << QByteArray("a9993e364706816aba3e25717850c26c9cd0d89d")
+                         << QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    QTest::newRow("55 bytes") << QByteArray(55, 'a') << QByteArray("ef1772b6dff9a122358552954ad0df65")
+                              << QByteArray("c1c8bbdc22796e28c0e15163d20899b65621d65a")
+                              << QByteArray("9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318");
+    QTest::newRow("56 bytes") << QByteArray(56, 'a') << QByteArray("3b0c8ac703f828b04c6c197006d17218")
+                              << QByteArray("c2db330f6083854c99d4b5bfb6e8f29f201be699")
+                              << QByteArray("b35439a4ac6f0948b6d6f9e3c6af0f5f590ce20f1bde7090ef7970686ec6738a");
+    QTest::newRow("64 bytes") << QByteArray(64, 'a') << QByteArray("014842d480b571495a4a0363793f7367")
+                              << QByteArray("0098ba824b5c16427bd7a1122a5a442a25ec644d")
+                              << QByteArray("ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb");
+}
+
+void UtilTest::stdDataHash(){
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, md5);
+    QFETCH(QByteArray, sha1);
+    QFETCH(QByteArray, sha256);
+
+    const std::string_view dataView(data.constData(), size_t(data.size()));
+
+    QCOMPARE(QByteArray::fromStdString(Util::Std::FileSystem::dataHash(dataView, Util::Std::FileSystem::HashAlgorithm::Md5)), md5);
+    QCOMPARE(QByteArray::fromStdString(Util::Std::FileSystem::dataHash(dataView, Util::Std::FileSystem::HashAlgorithm::Sha1)), sha1);
+    QCOMPARE(QByteArray::fromStdString(Util::Std::FileSystem::dataHash(dataView, Util::Std::FileSystem::HashAlgorithm::Sha256)), sha256);
+}
+
+// Same digests as QCryptographicHash for every size up to a few blocks
+void UtilTest::stdDataHashRandom(){
+    std::mt19937 generator(26);
+
+    for(int i = 0; i < 300; i++){
+        QByteArray data(i, Qt::Uninitialized);
+        for(char &currByte : data){
+            currByte = char(generator());
+        }
+
+        const std::string_view dataView(data.constData(), size_t(data.size()));
+
+        QCOMPARE(QByteArray::fromStdString(Util::Std::FileSystem::dataHash(dataView, Util::Std::FileSystem::HashAlgorithm::Md5)),
+                 QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
+        QCOMPARE(QByteArray::fromStdString(Util::Std::FileSystem::dataHash(dataView, Util::Std::FileSystem::HashAlgorithm::Sha1)),
+                 QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+        QCOMPARE(QByteArray::fromStdString(Util::Std::FileSystem::dataHash(dataView, Util::Std::FileSystem::HashAlgorithm::Sha256)),
+                 QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+    }
+}
+
+namespace {
+
+QStringList qtSplit(const QString &text, const QString &separator, const Qt::CaseSensitivity cs){
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    return text.split(separator, Qt::KeepEmptyParts, cs);
+#else
+    return text.split(separator, QString::KeepEmptyParts, cs);
+#endif
+}
+
+QStringList tokenizerStrings(const QString &text, const QString &separator, const Qt::CaseSensitivity cs){
+    QStringList result;
+
+    for(Util::String::StringTokenizer tokenizer(text, separator, cs); tokenizer.hasNext();){
+        result << tokenizer.next().toString();
+    }
+
+    return result;
+}
+
+QStringList splitViewStrings(const QString &text, const QString &separator, const Qt::CaseSensitivity cs){
+    QStringList result;
+
+    for(const QStringView &currToken : Util::String::splitView(text, separator, cs)){
+        result << currToken.toString();
+    }
+
+    return result;
+}
+
+}
+
+// splitView, StringTokenizer and substring give the same tokens as QString::split (keeping the empty ones)
+void UtilTest::splitView_data(){
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QString>("separator");
+    QTest::addColumn<bool>("isCaseSensitive");
+
+    QTest::newRow("empty text") << "" << "," << true;
+    QTest::newRow("no separator") << "abc" << "," << true;
+    QTest::newRow("empty tokens") << ",a,,b," << "," << true;
+    QTest::newRow("only separators") << ",,," << "," << true;
+    QTest::newRow("lines") << "a\r\nb\r\n\r\nc" << "\r\n" << true;
+    QTest::newRow("overlapping") << "aaaaa" << "aa" << true;
+    QTest::newRow("long separator") << "x<separator-longer-than-16>y<separator-longer-than-16>" << "<separator-longer-than-16>" << true;
+    QTest::newRow("case insensitive") << "aXbxc" << "x" << false;
+    QTest::newRow("case insensitive long") << "a<SEPARATOR-LONGER-THAN-16>b<separator-longer-than-16>c" << "<Separator-Longer-Than-16>" << false;
+    QTest::newRow("surrogate pairs") << surrogatePair() + "," + surrogatePair() << "," << true;
+}
+
+void UtilTest::splitView(){
+    QFETCH(QString, text);
+    QFETCH(QString, separator);
+    QFETCH(bool, isCaseSensitive);
+
+    const Qt::CaseSensitivity cs = isCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    const QStringList expected = qtSplit(text, separator, cs);
+
+    QCOMPARE(splitViewStrings(text, separator, cs), expected);
+    QCOMPARE(tokenizerStrings(text, separator, cs), expected);
+    QCOMPARE(Util::String::substring(text, separator, cs), expected);
+}
+
+void UtilTest::splitViewRandom(){
+    std::mt19937 generator(13);
+    const QStringList alphabet = QStringList() << "a" << "b" << "A" << "ab" << "," << "\r\n" << surrogatePair();
+
+    for(int i = 0; i < 5000; i++){
+        const QString separator = randomString(generator, alphabet, i % 10 == 0 ? 20 : 3);
+        const Qt::CaseSensitivity cs = generator() % 2 == 0 ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+        if(separator.isEmpty()){
+            continue; // QString::split splits between every char then
+        }
+
+        QString text;
+        for(int j = int(generator() % 8); j > 0; j--){
+            text += randomString(generator, alphabet, 6) + (generator() % 2 == 0 ? separator : separator.toUpper());
+        }
+
+        const QStringList expected = qtSplit(text, separator, cs);
+
+        QCOMPARE(splitViewStrings(text, separator, cs), expected);
+        QCOMPARE(tokenizerStrings(text, separator, cs), expected);
+        QCOMPARE(Util::String::substring(text, separator, cs), expected);
+    }
+
+    // an empty separator doesn't split anything
+    QCOMPARE(splitViewStrings("abc", QString(), Qt::CaseSensitive), QStringList() << "abc");
+    QCOMPARE(tokenizerStrings("abc", QString(), Qt::CaseSensitive), QStringList() << "abc");
+}
+
+namespace {
+
+// fullTrim before the vectorized version
+QString oldFullTrim(QString str){
+    str = str.simplified(); //convert all invisible chars in normal whitespaces
+    str.replace(" ", "");
+    return str;
+}
+
+}
+
+// Whitespace and near misses on both sides of the 8 / 16 char SSE2 / AVX2 blocks
+void UtilTest::fullTrim_data(){
+    QTest::addColumn<QString>("text");
+
+    const QVector<ushort> specialChars = QVector<ushort>() << 0x09 << 0x0D << 0x0E << 0x1F << 0x20 << 0x84 << 0x85 << 0xA0 << 0xA1
+                                                           << 0x167F << 0x1680 << 0x2000 << 0x200A << 0x200B << 0x2027 << 0x2028
+                                                           << 0x2029 << 0x202A << 0x202F << 0x205F << 0x3000 << 0xFEFF;
+    const QVector<int> positions = QVector<int>() << 0 << 7 << 8 << 15 << 16 << 17 << 31 << 32 << 39;
+
+    for(const ushort currChar : specialChars){
+        for(const int currPosition : positions){
+            QString text(40, 'x');
+            text[currPosition] = QChar(currChar);
+            QTest::newRow(qPrintable(QString("U+%1 at %2").arg(currChar, 4, 16, QChar('0')).arg(currPosition))) << text;
+        }
+    }
+
+    QTest::newRow("empty") << "";
+    QTest::newRow("only whitespace") << QString(40, QChar(0x3000));
+    QTest::newRow("no whitespace") << QString(40, 'x');
+    QTest::newRow("surrogate pairs") << surrogatePair() + " " + surrogatePair() + QString(20, 'x') + "\t" + surrogatePair();
+}
+
+void UtilTest::fullTrim(){
+    QFETCH(QString, text);
+
+    const QString expected = oldFullTrim(text);
+    QString inPlace = text;
+    Util::String::fullTrimInPlace(inPlace);
+
+    QCOMPARE(Util::String::fullTrim(text), expected);
+    QCOMPARE(Util::String::fullTrim(QStringView(text)), expected);
+    QCOMPARE(inPlace, expected);
+}
+
+void UtilTest::fullTrimRandom(){
+    std::mt19937 generator(14);
+    QStringList alphabet = QStringList() << "a" << "b" << "xyzxyzxy" << " " << "\t" << "\r\n" << surrogatePair();
+
+    for(const ushort currChar : {0x85, 0xA0, 0x1680, 0x2005, 0x200B, 0x2028, 0x2029, 0x202F, 0x205F, 0x3000}){
+        alphabet << QString(QChar(currChar));
+    }
+
+    for(int i = 0; i < 5000; i++){
+        const QString text = randomString(generator, alphabet, 40);
+        const QString expected = oldFullTrim(text);
+        QString inPlace = text;
+        Util::String::fullTrimInPlace(inPlace);
+
+        QCOMPARE(Util::String::fullTrim(text), expected);
+        QCOMPARE(Util::String::fullTrim(QStringView(text)), expected);
+        QCOMPARE(inPlace, expected);
+    }
+}
+
+namespace {
+
+// What QProcess makes of the command line (it drops the empty arguments), empty before Qt 5.15 which has no splitCommand
+QStringList splitCommandLine(const QString &commandLine){
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    return QProcess::splitCommand(commandLine);
+#else
+    Q_UNUSED(commandLine);
+    return QStringList();
+#endif
+}
+
+bool canSplitCommandLine(){
+    return QT_VERSION >= QT_VERSION_CHECK(5, 15, 0);
+}
+
+QStringList withoutEmpty(QStringList arguments){
+    arguments.removeAll(QString());
+    return arguments;
+}
+
+}
+
+// Single paths are quoted like normalizeAndQuote, and any command line splits back into its arguments
+void UtilTest::commandLineBuilder_data(){
+    QTest::addColumn<QString>("path");
+
+    QTest::newRow("plain") << "C:\\folder\\file.txt";
+    QTest::newRow("spaces") << "/my folder/my file.txt";
+    QTest::newRow("non ascii") << "/pasta/ficheiro" + QString(QChar(0xE9)) + surrogatePair();
+    QTest::newRow("empty") << "";
+}
+
+void UtilTest::commandLineBuilder(){
+    QFETCH(QString, path);
+
+    Util::System::CommandLineBuilder builder;
+    builder.addPath(path);
+
+    QCOMPARE(builder.toString(), Util::FileSystem::normalizeAndQuote(path));
+    QCOMPARE(builder.toArguments(), QStringList() << Util::FileSystem::normalizePath(path));
+}
+
+void UtilTest::commandLineBuilderRandom(){
+    if(!canSplitCommandLine()){
+        QSKIP("QProcess::splitCommand needs Qt 5.15");
+    }
+
+    std::mt19937 generator(17);
+    const QStringList alphabet = QStringList() << "a" << "b" << "-" << " " << "\t" << "\n" << "\"" << "\"\"" << "\\" << "'" << "%" << "&"
+                                               << "$" << "*" << QString(QChar(0xE9)) << QString(QChar(0x3000)) << surrogatePair();
+
+    for(int i = 0; i < 5000; i++){
+        Util::System::CommandLineBuilder builder(i % 2 == 0 ? 0 : 256); // growing the buffer too
+        QStringList expected;
+
+        for(int j = int(generator() % 6); j > 0; j--){
+            const QString currArgument = randomString(generator, alphabet, 8);
+
+            if(generator() % 3 == 0){
+                builder.addPath(currArgument);
+                expected << Util::FileSystem::normalizePath(currArgument);
+            }
+            else{
+                builder.addArgument(currArgument, generator() % 4 == 0);
+                expected << currArgument;
+            }
+        }
+
+        QCOMPARE(builder.size(), expected.size());
+        QCOMPARE(builder.toArguments(), expected);
+        QCOMPARE(splitCommandLine(builder.toString()), withoutEmpty(expected));
+    }
+}
+
+namespace {
+
+// Validation before the fast paths
+int oldFirstNonInteger(const QStringList &values){
+    for(int i = 0; i < values.size(); i++){
+        bool isNumber;
+        values.at(i).toInt(&isNumber);
+        if(!isNumber){
+            return i;
+        }
+    }
+    return -1;
+}
+
+int oldFirstNonDouble(const QStringList &values){
+    for(int i = 0; i < values.size(); i++){
+        bool isDouble;
+        values.at(i).toDouble(&isDouble);
+        if(!isDouble){
+            return i;
+        }
+    }
+    return -1;
+}
+
+}
+
+// isStringInteger / isStringDouble decide the same as toInt / toDouble, the fast paths included
+void UtilTest::numberValidation_data(){
+    QTest::addColumn<QString>("value");
+
+    QTest::newRow("empty") << "";
+    QTest::newRow("zero") << "0";
+    QTest::newRow("minus zero") << "-0";
+    QTest::newRow("plus") << "+5";
+    QTest::newRow("signs only") << "-";
+    QTest::newRow("9 digits") << "999999999";
+    QTest::newRow("10 digits") << "2147483647";
+    QTest::newRow("int overflow") << "2147483648";
+    QTest::newRow("int min") << "-2147483648";
+    QTest::newRow("int underflow") << "-2147483649";
+    QTest::newRow("leading zeros") << "0000000000000001";
+    QTest::newRow("whitespace") << " 5 ";
+    QTest::newRow("tab") << "\t5";
+    QTest::newRow("decimal") << "1.5";
+    QTest::newRow("comma") << "1,5";
+    QTest::newRow("no integer part") << ".5";
+    QTest::newRow("no fraction") << "5.";
+    QTest::newRow("exponent") << "1e10";
+    QTest::newRow("big exponent") << "1e999";
+    QTest::newRow("negative exponent") << "-1.5E-99";
+    QTest::newRow("exponent without digits") << "1e";
+    QTest::newRow("hex") << "0x10";
+    QTest::newRow("inf") << "inf";
+    QTest::newRow("nan") << "nan";
+    QTest::newRow("letters") << "5a";
+    QTest::newRow("arabic digits") << QString(QChar(0x0661));
+    QTest::newRow("fullwidth digits") << QString(QChar(0xFF11));
+    QTest::newRow("64 digits") << QString(64, '9');
+    QTest::newRow("65 digits") << QString(65, '9');
+}
+
+void UtilTest::numberValidation(){
+    QFETCH(QString, value);
+
+    bool isNumber, isDouble;
+    value.toInt(&isNumber);
+    value.toDouble(&isDouble);
+
+    QCOMPARE(Util::Validation::isStringInteger(value), isNumber);
+    QCOMPARE(Util::Validation::isStringDouble(value), isDouble);
+    QCOMPARE(Util::Validation::checkIfIntegers(QStringList() << "1" << value), !isNumber);
+    QCOMPARE(Util::Validation::checkIfDoubles(QStringList() << "1" << value), !isDouble);
+}
+
+void UtilTest::numberValidationRandom(){
+    std::mt19937 generator(18);
+    const QStringList alphabet = QStringList() << "0" << "1" << "5" << "9" << "-" << "+" << "." << "," << "e" << "E" << " " << "x";
+    QStringList values;
+
+    for(int i = 0; i < 20000; i++){
+        values << randomString(generator, alphabet, i % 100 == 0 ? 70 : 12);
+    }
+
+    for(const QString &currValue : values){
+        bool isNumber, isDouble;
+        currValue.toInt(&isNumber);
+        currValue.toDouble(&isDouble);
+
+        QVERIFY2(Util::Validation::isStringInteger(currValue) == isNumber, qPrintable(currValue));
+        QVERIFY2(Util::Validation::isStringDouble(currValue) == isDouble, qPrintable(currValue));
+    }
+}
+
+// Lists this big are split between threads, the first invalid one must still be the lowest index
+void UtilTest::firstInvalidParallel(){
+    QStringList values;
+
+    for(int i = 0; i < 300000; i++){
+        values << QString::number(i % 1000);
+    }
+
+    QCOMPARE(Util::Validation::firstNonInteger(values), -1);
+    QCOMPARE(Util::Validation::firstNonDouble(values), -1);
+
+    for(const int currInvalid : {0, 24999, 25000, 150000, 299999}){
+        QStringList currValues = values;
+        currValues[currInvalid] = "x";
+        currValues[qMin(currInvalid + 30000, currValues.size() - 1)] = "y"; // a later one, maybe seen first by another thread
+
+        for(const int currMaxThreads : {0, 1, 3}){
+            QCOMPARE(Util::Validation::firstNonInteger(currValues, currMaxThreads), oldFirstNonInteger(currValues));
+            QCOMPARE(Util::Validation::firstNonDouble(currValues, currMaxThreads), oldFirstNonDouble(currValues));
+        }
+    }
+}
+
+// A file written in the last seconds is hashed but not cached, a same size rewrite in the same timestamp tick must not get the old hash
+void UtilTest::fileHashCacheRecentlyModified(){
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString filePath = tempDir.filePath("file.txt");
+    Util::FileSystem::FileHashCache cache(tempDir.filePath("hashes.cache"));
+
+    for(const QByteArray &currContents : {QByteArray("first"), QByteArray("other")}){
+        QFile file(filePath);
+        QVERIFY(file.open(QFile::WriteOnly));
+        QCOMPARE(file.write(currContents), qint64(currContents.size()));
+        file.close();
+
+        QCOMPARE(cache.fileHash(filePath, QCryptographicHash::Sha1), QString(QCryptographicHash::hash(currContents, QCryptographicHash::Sha1).toHex()));
+        QCOMPARE(cache.size(), 0);
+    }
+}
+
+namespace {
+
+bool writeFile(const QString &filePath, const QByteArray &contents){
+    QFile file(filePath);
+    return file.open(QFile::WriteOnly) && file.write(contents) == contents.size();
+}
+
+}
+
+// Only the paths that really changed are reported, and a saved tree compares the same as the one it came from
+void UtilTest::directoryHashTree(){
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootPath = tempDir.path();
+    QVERIFY(QDir(rootPath).mkpath("a/b"));
+    QVERIFY(QDir(rootPath).mkpath("empty"));
+    QVERIFY(writeFile(rootPath + "/a/1.txt", "1"));
+    QVERIFY(writeFile(rootPath + "/a/b/2.txt", "2"));
+    QVERIFY(writeFile(rootPath + "/c.txt", "c"));
+
+    typedef Util::FileSystem::DirectoryHashTree Tree;
+
+    const Tree tree = Tree::build(rootPath, QCryptographicHash::Sha256);
+    QVERIFY(!tree.isEmpty());
+    QVERIFY(tree.errors().isEmpty());
+    QVERIFY(tree.changedPaths(Tree::build(rootPath, QCryptographicHash::Sha256, 1)).isEmpty());
+
+    QTemporaryDir cacheDir; // outside the tree, which would change otherwise
+    QVERIFY(cacheDir.isValid());
+
+    Util::FileSystem::FileHashCache cache(cacheDir.filePath("hashes.cache"));
+    QCOMPARE(Tree::build(rootPath, QCryptographicHash::Sha256, 0, &cache).rootHash(), tree.rootHash());
+
+    bool ok;
+    const Tree loadedTree = Tree::fromByteArray(tree.toByteArray(), &ok);
+    QVERIFY(ok);
+    QCOMPARE(loadedTree.rootHash(), tree.rootHash());
+    QVERIFY(loadedTree.changedPaths(tree).isEmpty());
+
+    QVERIFY(writeFile(rootPath + "/a/b/2.txt", "two"));
+    QVERIFY(writeFile(rootPath + "/empty/new.txt", "new"));
+    QVERIFY(QFile::remove(rootPath + "/c.txt"));
+
+    const Tree changedTree = Tree::build(rootPath, QCryptographicHash::Sha256);
+    QStringList changedPaths = changedTree.changedPaths(tree);
+    changedPaths.sort();
+
+    QCOMPARE(changedPaths, QStringList() << "a/b/2.txt" << "c.txt" << "empty/new.txt");
+    QVERIFY(changedTree.rootHash() != tree.rootHash());
+    QVERIFY(changedTree.hash("a") != tree.hash("a"));
+    QCOMPARE(changedTree.hash("a/1.txt"), tree.hash("a/1.txt"));
+
+    // another algorithm can't be compared, everything changed
+    QCOMPARE(Tree::build(rootPath, QCryptographicHash::Sha1).changedPaths(changedTree), QStringList() << QString());
+}
+
+QTEST_GUILESS_MAIN(UtilTest)
+
+#include "util_test.moc"
+
+/**
+ * Copyright (c) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
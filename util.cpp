@@ -13,14 +13,68 @@
 #include <QDebug>
 #endif
 
-#include <QRegularExpression>
 #include <QUrl>
 #include <QSettings>
 #include <QXmlStreamReader>
 #include <QDirIterator>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QMutex>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFutureInterface>
+#include <QVarLengthArray>
+#include <QLocale>
+#include <QtNumeric>
+#include <QtAlgorithms>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QtEndian>
+#include <QDataStream>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QSocketNotifier>
+#include <QFileSystemWatcher>
+#include <functional>
+#include <algorithm>
 #include <memory>
+#include <vector>
+#include <atomic>
+#include <climits>
 #include <string.h>
 
+#ifdef Q_OS_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+
+#ifndef FICLONE // older kernel headers
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
+// SSE2 is part of x86-64, AVX2 kernels are compiled with a target attribute and picked at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTIL_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTIL_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
 #ifdef QT_GUI_LIB
 #include <QCheckBox>
 #include <QHBoxLayout>
@@ -29,378 +83,3785 @@
 #include <QDesktopWidget>
 #include <QListView>
 #include <QTreeView>
+#include <QTimer>
+#include <QPainter>
+#include <QApplication>
+#include <QMouseEvent>
+#include <QKeyEvent>
+#include <QStyleOption>
 #endif
 
 namespace Util{
 
-namespace FileSystem {
+namespace {
 
-QString normalizePath(QString path){
-    return path.replace("\\","/");
-}
+// Runs a std::function in a QThreadPool (QRunnable::create is only available since Qt 5.15)
+class FunctionRunnable : public QRunnable{
+public:
+    explicit FunctionRunnable(std::function<void()> function) : function(std::move(function)){
+        setAutoDelete(true);
+    }
 
-QString cutName(QString path){
-    return path.remove(0,path.lastIndexOf('/')).remove('"');
-}
+    void run() override{
+        function();
+    }
 
-QString cutNameWithoutBackSlash(QString path){
-    return cutName(path).remove('/');
-}
+private:
+    std::function<void()> function;
+};
 
-QString normalizeAndQuote(QString path){
-    return String::insertQuotes(normalizePath(path));
+int resolveThreadCount(const int maxThreads){
+    return maxThreads > 0 ? maxThreads : qMax(1, QThread::idealThreadCount());
 }
 
-// Created from scratch
-bool copyDir(const QString &fromPath, QString toPath, const bool isRecursive){
-    QDir fromDir(fromPath);
-    QDir toDir(toPath);
+// Calls function(i) for every i in [0, count[ using up to maxThreads threads (the calling one included)
+void parallelFor(const int count, const int maxThreads, const std::function<void(int)> &function){
+    std::atomic<int> nextIndex(0);
 
-    if(!toDir.mkdir(fromDir.dirName())){ // create the folder in the destination
-        return false;
-    }
+    auto runNext = [&](){
+        for(int i = nextIndex++; i < count; i = nextIndex++){
+            function(i);
+        }
+    };
+
+    const int threadCount = qMin(resolveThreadCount(maxThreads), count);
 
-    // Update toPath to include the folder from "fromPath"
-    toPath = toPath + "/" + fromDir.dirName();
-    toDir = QDir(toPath);
+    QThreadPool workers;
+    workers.setMaxThreadCount(qMax(1, threadCount));
 
-    for(const QFileInfo &currFileInfo : fromDir.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot)){
+    for(int i = 1; i < threadCount; i++){
+        workers.start(new FunctionRunnable(runNext));
+    }
 
-        if(currFileInfo.isFile()){
+    runNext();
+    workers.waitForDone();
+}
 
-            QFile destFile(toPath + "/" + currFileInfo.fileName());
+// Index of character in [from, size[ or -1
+int indexOfChar(const ushort *data, const int size, const ushort character, int from = 0){
+    int i = from;
 
-            if(!QFile::copy(currFileInfo.absoluteFilePath(),toPath + "/" + currFileInfo.fileName())){
-                return false;
-            }
+#ifdef UTIL_SSE2
+    const __m128i needle = _mm_set1_epi16(short(character));
+
+    for(; i + 8 <= size; i += 8){
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle));
+        if(mask != 0){
+            return i + qCountTrailingZeroBits(quint32(mask)) / 2;
         }
-        else if(isRecursive && currFileInfo.isDir() && currFileInfo.absoluteFilePath() != fromDir.absolutePath()){
+    }
+#endif
 
-            if(!copyDir(currFileInfo.absoluteFilePath(), toPath, isRecursive)){
-                return false;
-            }
+    for(; i < size; i++){
+        if(data[i] == character){
+            return i;
         }
     }
 
-    return true;
+    return -1;
 }
 
-//Copied from here: http://stackoverflow.com/questions/2536524/copy-directory-using-qt (ty roop)
-bool rmDir(const QString &dirPath)
-{
-    QDir dir(dirPath);
-    if (!dir.exists())
-        return true;
-    for(const QFileInfo &info : dir.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot)) {
-        if (info.isDir()) {
-            if (!rmDir(info.filePath()))
-                return false;
-        } else {
-            if (!dir.remove(info.fileName()))
-                return false;
+// Index of the last character in [0, size[ or -1
+int lastIndexOfChar(const ushort *data, const int size, const ushort character){
+    int i = size;
+
+#ifdef UTIL_SSE2
+    const __m128i needle = _mm_set1_epi16(short(character));
+
+    for(; i >= 8; i -= 8){
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 8)), needle));
+        if(mask != 0){
+            return i - 8 + (31 - int(qCountLeadingZeroBits(quint32(mask)))) / 2;
         }
     }
-    QDir parentDir(QFileInfo(dirPath).path());
-    return parentDir.rmdir(QFileInfo(dirPath).fileName());
-}
+#endif
 
-// Gets all files from a folder filtered by a given wildcard
-QStringList getFolderFilesByWildcard(const QString &entryFolder, const QString &wildcard, bool isRecursive){
+    while(i > 0){
+        i--;
+        if(data[i] == character){
+            return i;
+        }
+    }
 
-    QStringList filesFound; // result files with absolute path
+    return -1;
+}
 
-    QDirIterator it(entryFolder, QDir::Files, (isRecursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags));
+// Replaces before by after in one pass, the string is only detached if it has a before character
+void replaceChar(QString &str, const ushort before, const ushort after){
+    const int size = str.size();
+    const int first = indexOfChar(str.utf16(), size, before);
 
-    while (it.hasNext()){
-        filesFound << it.next();
+    if(first == -1){
+        return;
     }
 
-    return filterFilesByWildcard(filesFound, wildcard);
-}
+    ushort *data = reinterpret_cast<ushort*>(str.data());
+    int i = first;
 
-// Supports wildcards, and subdirectories with wildcard e.g.:
-// *.xml
-// /myXmls/*.xml
-//
-// online helper: https://regex101.com/
-QStringList filterFilesByWildcard(const QStringList &filePaths, const QString &wildcard){
-    QStringList resultFiles;
-    QString formattedWildcard;
+#ifdef UTIL_SSE2
+    const __m128i beforeChars = _mm_set1_epi16(short(before));
+    const __m128i afterChars = _mm_set1_epi16(short(after));
 
-    if(wildcard.trimmed().isEmpty()){
-        return resultFiles;
+    for(; i + 8 <= size; i += 8){
+        __m128i *block = reinterpret_cast<__m128i*>(data + i);
+        const __m128i chars = _mm_loadu_si128(block);
+        const __m128i matches = _mm_cmpeq_epi16(chars, beforeChars);
+        _mm_storeu_si128(block, _mm_or_si128(_mm_and_si128(matches, afterChars), _mm_andnot_si128(matches, chars)));
     }
+#endif
 
-    formattedWildcard=normalizePath(wildcard); // Convert slashes to work in both mac and windows
+    for(; i < size; i++){
+        if(data[i] == before){
+            data[i] = after;
+        }
+    }
+}
 
-    // escape the string so '.' or '(' chars get correctly escaped
-    formattedWildcard = QRegularExpression::escape(formattedWildcard);
+}
 
-    // replace * by the corresponding regex
-    formattedWildcard.replace("\\*",".*");
+namespace FileSystem {
 
-    // replace ? by the corresponding regex
-    formattedWildcard.replace("\\?",".");
+namespace Instrumentation {
 
-    // if it doesn't start with any regex wildcard or a subdirectory slash, add a slash to beginning (so the file/folder matches at least the root folder)
-    // We use \\/ instead of / because it was escaped
-    if(!formattedWildcard.startsWith("\\/") && !formattedWildcard.startsWith(".*") && !formattedWildcard.startsWith(".")){
-        formattedWildcard = "\\/" + formattedWildcard;
-    }
+namespace {
 
-    // if it is a subdirectory add * to match
-    if(formattedWildcard.startsWith("\\/")){
-        formattedWildcard = ".*" + formattedWildcard;
-    }
+std::atomic<bool> instrumentationEnabled(false);
+std::atomic<quint64> filesVisitedCounter(0);
+std::atomic<quint64> bytesReadCounter(0);
+std::atomic<quint64> bytesWrittenCounter(0);
+std::atomic<quint64> syscallsCounter(0);
+std::atomic<quint64> errorsCounter(0);
 
-    formattedWildcard = "^" + formattedWildcard + "$"; // we want a full match (http://stackoverflow.com/a/5752852)
+struct TraceEvent{
+    const char *name;
+    qint64 start; // nanoseconds since the instrumentation clock started
+    qint64 duration;
+    quint64 threadId;
+};
 
-    QRegularExpression regex(formattedWildcard);
+// keeps the trace memory bounded, the phase totals are still updated after this
+const int maxTraceEvents = 1000000;
 
-    for(const QString &currentFile : filePaths){
+QMutex traceMutex;
+std::vector<TraceEvent> traceEvents;
+QHash<const char*, PhaseStats> phaseStats;
 
-        if(regex.match(currentFile).hasMatch()){
-            resultFiles << currentFile;
-        }
+QElapsedTimer &instrumentationClock(){
+    static QElapsedTimer clock;
+    return clock;
+}
 
-    }
+inline bool enabled(){
+    return instrumentationEnabled.load(std::memory_order_relaxed);
+}
 
-    return resultFiles;
+inline void add(std::atomic<quint64> &counter, const quint64 value){
+    if(enabled()){
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
 }
 
-// Returns empty QString on failure.
-// Based from here: http://www.qtcentre.org/archive/index.php/t-35674.html (thanks wysota!)
-QString fileHash(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm)
-{
+inline void addFilesVisited(const quint64 count = 1){ add(filesVisitedCounter, count); }
+inline void addBytesRead(const quint64 count){ add(bytesReadCounter, count); }
+inline void addBytesWritten(const quint64 count){ add(bytesWrittenCounter, count); }
+inline void addSyscalls(const quint64 count = 1){ add(syscallsCounter, count); }
+inline void addErrors(const quint64 count = 1){ add(errorsCounter, count); }
 
-    QCryptographicHash crypto(hashAlgorithm);
-    QFile file(fileName);
-    file.open(QFile::ReadOnly);
-    while(!file.atEnd()){
-        crypto.addData(file.read(8192));
+// Times the enclosing scope as a phase (name must be a string literal)
+class ScopedPhase{
+public:
+    explicit ScopedPhase(const char *name) : name(enabled() ? name : nullptr), start(this->name != nullptr ? instrumentationClock().nsecsElapsed() : 0){
     }
-    QByteArray hash = crypto.result();
 
-    return QString(crypto.result().toHex());
+    ~ScopedPhase(){
+        if(name == nullptr){
+            return;
+        }
 
-}
+        const qint64 duration = instrumentationClock().nsecsElapsed() - start;
 
+        QMutexLocker locker(&traceMutex);
 
-/**
-  Gets application directory. In mac os gets the .app directory
-  **/
-QString getAppPath(){
-#ifdef Q_OS_MAC
-    QDir dir = QDir(QCoreApplication::applicationDirPath());
-    if(dir.absolutePath().contains(".app")){ // include bundle, but we don't want it
-        dir.cdUp();
-        dir.cdUp();
-        dir.cdUp();
+        PhaseStats &currStats = phaseStats[name];
+        currStats.calls++;
+        currStats.totalNanoseconds += duration;
+
+        if(int(traceEvents.size()) < maxTraceEvents){
+            traceEvents.push_back(TraceEvent{name, start, duration, quint64(quintptr(QThread::currentThreadId()))});
+        }
     }
-    return dir.absolutePath();
-#else
-    return  QDir::currentPath();
-#endif
+
+private:
+    const char *name;
+    const qint64 start;
+
+    Q_DISABLE_COPY(ScopedPhase)
+};
+
 }
 
-bool backupFile(const QString &file, QString newFilename){
-	
-	if(newFilename.isEmpty()){
-		newFilename = file;
-	}
-	
-    return QFile::copy(file, newFilename+".bak");
+void setEnabled(bool enabled){
+    if(enabled){
+        QMutexLocker locker(&traceMutex);
+        if(!instrumentationClock().isValid()){
+            instrumentationClock().start();
+        }
+    }
+    instrumentationEnabled = enabled;
 }
 
+bool isEnabled(){
+    return enabled();
 }
 
-namespace String {
+void reset(){
+    filesVisitedCounter = 0;
+    bytesReadCounter = 0;
+    bytesWrittenCounter = 0;
+    syscallsCounter = 0;
+    errorsCounter = 0;
 
-QString insertApostrophes(const QString &currString){
-    return "'"+currString+"'";
+    QMutexLocker locker(&traceMutex);
+    traceEvents.clear();
+    phaseStats.clear();
 }
 
-QString insertQuotes(const QString &currString){
-    return "\""+currString+"\"";
-}
+Snapshot snapshot(){
+    Snapshot currSnapshot;
 
-QString fullTrim(QString str) {
+    currSnapshot.filesVisited = filesVisitedCounter;
+    currSnapshot.bytesRead = bytesReadCounter;
+    currSnapshot.bytesWritten = bytesWrittenCounter;
+    currSnapshot.syscalls = syscallsCounter;
+    currSnapshot.errors = errorsCounter;
 
-    str = str.simplified(); //convert all invisible chars in normal whitespaces
-    str.replace( " ", "" );
+    QMutexLocker locker(&traceMutex);
 
-    return str;
-}
+    for(auto it = phaseStats.constBegin(); it != phaseStats.constEnd(); ++it){
+        currSnapshot.phases.insert(QString::fromLatin1(it.key()), it.value());
+    }
 
-QStringList substring(QString myString, QString separator, Qt::CaseSensitivity cs){
-    QStringList result = QStringList();
-    int currIdx=0, nextIdx=0;
+    return currSnapshot;
+}
 
-    while(true){
-        nextIdx=myString.indexOf(separator,currIdx,cs);
-        result << myString.mid(currIdx,nextIdx-currIdx);
-        if(nextIdx==-1) break;
-        currIdx=nextIdx+1;
+// Trace Event Format, can be opened in chrome://tracing or https://ui.perfetto.dev
+QByteArray toChromeTraceJson(){
+    const Snapshot currSnapshot = snapshot();
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray json;
+
+    QMutexLocker locker(&traceMutex);
+
+    json.reserve(int(traceEvents.size()) * 96 + 512);
+    json += "{\"traceEvents\":[";
+
+    for(const TraceEvent &currEvent : traceEvents){
+        json += "{\"name\":\"";
+        json += currEvent.name;
+        json += "\",\"cat\":\"FileSystem\",\"ph\":\"X\",\"ts\":";
+        json += QByteArray::number(currEvent.start / 1000.0, 'f', 3); // microseconds
+        json += ",\"dur\":";
+        json += QByteArray::number(currEvent.duration / 1000.0, 'f', 3);
+        json += ",\"pid\":" + pid + ",\"tid\":";
+        json += QByteArray::number(currEvent.threadId);
+        json += "},";
     }
 
-    return result;
+    // the counters at the end of the trace
+    json += "{\"name\":\"FileSystem counters\",\"ph\":\"C\",\"ts\":";
+    json += QByteArray::number(instrumentationClock().isValid() ? instrumentationClock().nsecsElapsed() / 1000.0 : 0.0, 'f', 3);
+    json += ",\"pid\":" + pid + ",\"args\":{";
+    json += "\"filesVisited\":" + QByteArray::number(currSnapshot.filesVisited);
+    json += ",\"bytesRead\":" + QByteArray::number(currSnapshot.bytesRead);
+    json += ",\"bytesWritten\":" + QByteArray::number(currSnapshot.bytesWritten);
+    json += ",\"syscalls\":" + QByteArray::number(currSnapshot.syscalls);
+    json += ",\"errors\":" + QByteArray::number(currSnapshot.errors);
+    json += "}}],\"displayTimeUnit\":\"ns\"}";
+
+    return json;
 }
 
-QString normalizeDecimalSeparator(QString value){
-    return value.replace(',','.');
 }
 
-//Searches for the QString "toSearch" in the "myString" variable backward
-//Returns the index of the first match or -1 if not found
-int indexOfBackward(QString myString, QString toSearch, int from){
-    int myStringSize=myString.size();
-    int toSearchSize=toSearch.size();
+QString normalizePath(QString path){
+    normalizePathInPlace(path);
+    return path;
+}
+
+void normalizePathInPlace(QString &path){
+    replaceChar(path, '\\', '/');
+}
 
-    if(from==-1){
-        from=myStringSize;
+void normalizePaths(QStringList &paths){
+    for(QString &currPath : paths){
+        replaceChar(currPath, '\\', '/');
     }
+}
 
-    int i=from;
+namespace {
 
-    while(i>=0){
-        for(int j=toSearchSize-1; j>=0; j--){
-            i--;
-            if(myString.at(i)!=toSearch.at(j)){
-                break;
-            }
-            if(j==0){
-                return i;
-            }
+// path from the index "from" without the quotes, shared with path when possible
+QString nameWithoutQuotes(const QString &path, const int from){
+    const ushort *data = path.utf16();
+    const int size = path.size();
+
+    if(indexOfChar(data, size, '"', from) == -1){
+        return from == 0 ? path : path.mid(from);
+    }
+
+    QString result(size - from, Qt::Uninitialized);
+    ushort *resultData = reinterpret_cast<ushort*>(result.data());
+    int resultSize = 0;
+
+    for(int i = from; i < size; i++){
+        if(data[i] != '"'){
+            resultData[resultSize++] = data[i];
         }
     }
 
-    return -1;
-}
+    result.resize(resultSize);
 
-// no problem here with "temporary" cstr
-// https://stackoverflow.com/questions/1971183/when-does-c-allocate-deallocate-string-literals
-const char* boolToCstr(bool currentBoolean){
-    return currentBoolean ? "true" : "false";
+    return result;
 }
 
 }
 
-#ifdef QT_GUI_LIB
-namespace Dialogs {
+QString cutName(QString path){
+    return nameWithoutQuotes(path, qMax(0, lastIndexOfChar(path.utf16(), path.size(), '/')));
+}
 
-void showInfo(const QString &message, const bool richText){
-    QMessageBox msgBox;
-	if(richText){
-		msgBox.setTextFormat(Qt::RichText);
-	}
-    msgBox.setIcon(QMessageBox::Information);
-    msgBox.setText(message);
-    msgBox.exec();
+QString cutNameWithoutBackSlash(QString path){
+    // only the last slash is left after cutName
+    return nameWithoutQuotes(path, lastIndexOfChar(path.utf16(), path.size(), '/') + 1);
 }
 
-void showWarning(const QString &message, const bool richText){
-    QMessageBox msgBox;
-	if(richText){
-		msgBox.setTextFormat(Qt::RichText);
-	}
-    msgBox.setIcon(QMessageBox::Warning);
-    msgBox.setText(message);
-    msgBox.exec();
+QStringView cutNameView(QStringView path){
+    QStringView name = path.mid(lastIndexOfChar(reinterpret_cast<const ushort*>(path.data()), int(path.size()), '/') + 1);
+
+    while(!name.isEmpty() && name.front() == QLatin1Char('"')){
+        name = name.mid(1);
+    }
+    while(!name.isEmpty() && name.back() == QLatin1Char('"')){
+        name.chop(1);
+    }
+
+    return name;
 }
 
-void showError(const QString &message, const bool richText){
-    QMessageBox msgBox;
-	if(richText){
-		msgBox.setTextFormat(Qt::RichText);
-	}
-    msgBox.setIcon(QMessageBox::Critical);
-    msgBox.setText(message);
-    msgBox.exec();
+QVector<QStringView> cutNameViews(const QStringList &paths){
+    QVector<QStringView> result;
+    result.reserve(paths.size());
+
+    for(const QString &currPath : paths){
+        result << cutNameView(currPath);
+    }
+
+    return result;
 }
 
-bool showQuestion(QWidget * parent, QString message, QMessageBox::StandardButton standardButton){
-    return QMessageBox::question (parent, "Are you sure?", message, QMessageBox::Yes | QMessageBox::No, standardButton)==QMessageBox::Yes;
+QString normalizeAndQuote(QString path){
+    return String::insertQuotes(normalizePath(path));
 }
 
-QMessageBox::StandardButton showQuestionWithCancel(QWidget * parent, QString message, QMessageBox::StandardButton standardButton){
-    return QMessageBox::question (parent, "Are you sure?", message, QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, standardButton);
+// Created from scratch
+bool copyDir(const QString &fromPath, QString toPath, const bool isRecursive){
+    CopyDirOptions options;
+    options.isRecursive = isRecursive;
+
+    return copyDir(fromPath, toPath, options).success();
 }
 
-QStringList multipleDirSelection(const QString &title){
-    QFileDialog w;
+namespace {
 
-    // We need to use non native dialog, because native doesn't support multiple folder selection
-    w.setOption(QFileDialog::DontUseNativeDialog,true);
+#ifdef Q_OS_LINUX
+// Copies all the data from sourceFd to destinationFd kernel side
+// (copy_file_range, then sendfile, then read/write as last resort)
+bool copyFdContents(const int sourceFd, const int destinationFd, qint64 &bytesCopied, QString &errorString){
+    const size_t chunkSize = 1 << 30;
+    bool useCopyFileRange = true;
+    bool useSendFile = true;
+    qint64 totalCopied = 0;
 
-    w.setFileMode(QFileDialog::DirectoryOnly);
+    while(true){
+        ssize_t copied;
 
-    w.setWindowTitle(title);
+        Instrumentation::addSyscalls();
 
-    QTreeView *t = w.findChild<QTreeView*>();
+        if(useCopyFileRange){
+            copied = ::copy_file_range(sourceFd, nullptr, destinationFd, nullptr, chunkSize, 0);
+            // not supported by the kernel / filesystem pair, try the next method
+            if(copied == -1 && totalCopied == 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)){
+                useCopyFileRange = false;
+                continue;
+            }
+        }
+        else if(useSendFile){
+            copied = ::sendfile(destinationFd, sourceFd, nullptr, chunkSize);
+            if(copied == -1 && totalCopied == 0 && (errno == ENOSYS || errno == EINVAL)){
+                useSendFile = false;
+                continue;
+            }
+        }
+        else{
+            char buffer[65536];
+            copied = ::read(sourceFd, buffer, sizeof(buffer));
+            for(ssize_t written = 0; copied > 0 && written < copied;){
+                const ssize_t currWritten = ::write(destinationFd, buffer + written, copied - written);
+                Instrumentation::addSyscalls();
+                if(currWritten == -1){
+                    if(errno == EINTR){
+                        continue;
+                    }
+                    copied = -1;
+                    break;
+                }
+                written += currWritten;
+            }
+        }
 
-    if (t) {
-        t->setSelectionMode(QAbstractItemView::MultiSelection);
-    }
+        if(copied == -1){
+            if(errno == EINTR){
+                continue;
+            }
+            errorString = qt_error_string(errno);
+            return false;
+        }
 
-    if(w.exec()){ //if accepted
-        return w.selectedFiles();
+        if(copied == 0){ // end of file
+            break;
+        }
+
+        totalCopied += copied;
+        Instrumentation::addBytesRead(copied);
+        Instrumentation::addBytesWritten(copied);
     }
-    return QStringList(); //return empty
-}
 
+    bytesCopied += totalCopied;
+    return true;
 }
 #endif
 
-namespace Validation {
+CopyStrategy copyFileContentsImpl(const QString &sourcePath, const QString &destinationPath, const CloneMode cloneMode, qint64 &bytesCopied, QString &errorString);
 
-// Check if any string in the list is empty
-bool checkEmptySpaces(QStringList toCheck){
-    for (const QString &current : toCheck){
-        if(current.trimmed().isEmpty()){
-            return true; //There are empty spaces
-        }
-    }
-    return false;
-}
+// Copies a file into a new one (fails if it already exists, like QFile::copy)
+// Depending on cloneMode tries a hardlink and / or a copy-on-write clone before doing the full copy
+// Returns the strategy used (CopyStrategy::Failed on error)
+CopyStrategy copyFileContents(const QString &sourcePath, const QString &destinationPath, const CloneMode cloneMode, qint64 &bytesCopied, QString &errorString){
+    Instrumentation::ScopedPhase phase("copyFile");
+    Instrumentation::addFilesVisited();
 
-bool checkIfIntegers(QStringList toCheck){
-    for (const QString &current : toCheck){
-        if(!isStringInteger(current)){
-            return true; // Some aren't valid integers
-        }
-    }
-    return false;
-}
+    const CopyStrategy strategy = copyFileContentsImpl(sourcePath, destinationPath, cloneMode, bytesCopied, errorString);
 
-bool checkIfDoubles(QStringList toCheck){
-    for (const QString &current : toCheck){
-        if(!isStringDouble(current)){
-            return true; // Some aren't valid doubles
-        }
+    if(strategy == CopyStrategy::Failed){
+        Instrumentation::addErrors();
     }
-    return false;
+
+    return strategy;
 }
 
-bool isStringInteger(QString myString){
-    bool isNumber;
+CopyStrategy copyFileContentsImpl(const QString &sourcePath, const QString &destinationPath, const CloneMode cloneMode, qint64 &bytesCopied, QString &errorString){
+#ifdef Q_OS_LINUX
+    Instrumentation::addSyscalls(3); // open, fstat, open
 
-    myString.toInt(&isNumber); //convert to int and see if it succeeds
+    const QByteArray encodedSource = QFile::encodeName(sourcePath);
+    const QByteArray encodedDestination = QFile::encodeName(destinationPath);
+    const int sourceFd = ::open(encodedSource.constData(), O_RDONLY | O_CLOEXEC);
 
-    return isNumber;
-}
+    if(sourceFd == -1){
+        errorString = qt_error_string(errno);
+        return CopyStrategy::Failed;
+    }
 
-bool isStringDouble(QString myString){
-    bool isDouble;
+    struct stat sourceStat;
 
-    myString.toDouble(&isDouble); //convert to double and see if it succeeds
+    if(::fstat(sourceFd, &sourceStat) == -1){
+        errorString = qt_error_string(errno);
+        ::close(sourceFd);
+        return CopyStrategy::Failed;
+    }
 
-    return isDouble;
-}
+    if(cloneMode == CloneMode::ReflinkOrHardLink){
+        Instrumentation::addSyscalls(); // link
 
-}
+        // also fails if the destination exists, so nothing created by someone else is ever replaced
+        // (link() would hardlink a symlinked source itself instead of the file copied otherwise)
+        if(::linkat(AT_FDCWD, encodedSource.constData(), AT_FDCWD, encodedDestination.constData(), AT_SYMLINK_FOLLOW) == 0){
+            ::close(sourceFd);
+            bytesCopied += sourceStat.st_size;
+            return CopyStrategy::HardLink;
+        }
+
+        if(errno == EEXIST){
+            errorString = qt_error_string(errno);
+            ::close(sourceFd);
+            return CopyStrategy::Failed;
+        }
+        // hardlinks not possible here (e.g. different filesystems), so clone or copy it
+    }
+
+    const int destinationFd = ::open(encodedDestination.constData(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, sourceStat.st_mode & 07777);
+
+    if(destinationFd == -1){
+        errorString = qt_error_string(errno);
+        ::close(sourceFd);
+        return CopyStrategy::Failed;
+    }
+
+    CopyStrategy strategy = CopyStrategy::FullCopy;
+
+    Instrumentation::addSyscalls(cloneMode != CloneMode::Disabled ? 4 : 3); // ioctl, fchmod, close, close
+
+    if(cloneMode != CloneMode::Disabled && ::ioctl(destinationFd, FICLONE, sourceFd) == 0){
+        strategy = CopyStrategy::Reflink;
+        bytesCopied += sourceStat.st_size;
+    }
+
+    bool success = strategy == CopyStrategy::Reflink || copyFdContents(sourceFd, destinationFd, bytesCopied, errorString);
+
+    // same permissions as the source, regardless of the umask (like QFile::copy)
+    if(success && ::fchmod(destinationFd, sourceStat.st_mode & 07777) == -1){
+        errorString = qt_error_string(errno);
+        success = false;
+    }
+
+    if(::close(destinationFd) == -1 && success){
+        errorString = qt_error_string(errno);
+        success = false;
+    }
+
+    ::close(sourceFd);
+
+    if(!success){
+        ::unlink(encodedDestination.constData()); // don't leave partial files behind
+        return CopyStrategy::Failed;
+    }
+
+    return strategy;
+#else
+#ifdef Q_OS_UNIX
+    if(cloneMode == CloneMode::ReflinkOrHardLink
+            && ::linkat(AT_FDCWD, QFile::encodeName(sourcePath).constData(), AT_FDCWD, QFile::encodeName(destinationPath).constData(), AT_SYMLINK_FOLLOW) == 0){
+        bytesCopied += QFileInfo(sourcePath).size();
+        return CopyStrategy::HardLink;
+    }
+#endif
+
+    QFile sourceFile(sourcePath);
+
+    if(!sourceFile.copy(destinationPath)){
+        errorString = sourceFile.errorString();
+        return CopyStrategy::Failed;
+    }
+
+    bytesCopied += sourceFile.size();
+    return CopyStrategy::FullCopy;
+#endif
+}
+
+}
+
+CopyStrategy copyFile(const QString &sourcePath, const QString &destinationPath, const CloneMode cloneMode, QString *errorString){
+    qint64 bytesCopied = 0;
+    QString currErrorString;
+
+    const CopyStrategy strategy = copyFileContents(sourcePath, destinationPath, cloneMode, bytesCopied, currErrorString);
+
+    if(errorString != nullptr){
+        *errorString = currErrorString;
+    }
+
+    return strategy;
+}
+
+// Walks the source tree in the calling thread (creating the destination folders as it goes)
+// while the files are copied by a bounded worker pool
+CopyDirResult copyDir(const QString &fromPath, const QString &toPath, const CopyDirOptions &options){
+    Instrumentation::ScopedPhase phase("copyDir");
+    CopyDirResult result;
+    QDir fromDir(fromPath);
+    const QString rootDestination = toPath + "/" + fromDir.dirName();
+
+    if(!QDir(toPath).mkdir(fromDir.dirName())){ // create the folder in the destination
+        result.errors << CopyFileError{fromDir.absolutePath(), rootDestination, "Couldn't create the destination folder."};
+        return result;
+    }
+
+    const int threadCount = resolveThreadCount(options.maxThreads);
+
+    QThreadPool workers;
+    workers.setMaxThreadCount(threadCount);
+
+    // limit the queued copies, so huge trees don't get all their files queued in memory at once
+    QSemaphore queueSlots(threadCount * 64);
+    QMutex resultMutex;
+    qint64 filesFound = 0;
+    std::atomic<bool> wasFileSkipped(false); // only canceled if some work was really left undone
+
+    auto isCanceled = [&options](){
+        return options.isCanceled && options.isCanceled();
+    };
+
+    // pairs of (source folder, already created destination folder)
+    QList<QPair<QString, QString>> pendingFolders;
+    pendingFolders << qMakePair(fromDir.absolutePath(), rootDestination);
+
+    while(!pendingFolders.isEmpty() && !isCanceled()){
+
+        const QPair<QString, QString> currFolder = pendingFolders.takeLast();
+
+        for(const QFileInfo &currFileInfo : QDir(currFolder.first).entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot)){
+
+            const QString destinationPath = currFolder.second + "/" + currFileInfo.fileName();
+
+            if(currFileInfo.isFile()){
+
+                queueSlots.acquire();
+
+                const QString sourcePath = currFileInfo.absoluteFilePath();
+
+                {
+                    QMutexLocker locker(&resultMutex);
+                    filesFound++;
+                }
+
+                workers.start(new FunctionRunnable([sourcePath, destinationPath, &options, &isCanceled, &filesFound, &result, &resultMutex, &queueSlots, &wasFileSkipped](){
+                    if(isCanceled()){
+                        wasFileSkipped = true;
+                    }
+                    else{
+                        qint64 bytesCopied = 0;
+                        QString errorString;
+                        const CopyStrategy strategy = copyFileContents(sourcePath, destinationPath, options.cloneMode, bytesCopied, errorString);
+                        qint64 filesDone, currFilesFound;
+
+                        {
+                            QMutexLocker locker(&resultMutex);
+                            if(strategy != CopyStrategy::Failed){
+                                result.filesCopied++;
+                                result.bytesCopied += bytesCopied;
+                                result.copiedFiles << CopiedFile{sourcePath, destinationPath, strategy};
+                            }
+                            else{
+                                result.errors << CopyFileError{sourcePath, destinationPath, errorString};
+                            }
+
+                            filesDone = result.filesCopied + result.errors.size();
+                            currFilesFound = filesFound;
+                        }
+
+                        // outside the lock, so a slow callback doesn't hold the other workers
+                        if(options.progress){
+                            options.progress(filesDone, currFilesFound);
+                        }
+                    }
+
+                    queueSlots.release();
+                }));
+            }
+            else if(options.isRecursive && currFileInfo.isDir()){
+
+                Instrumentation::addFilesVisited();
+                Instrumentation::addSyscalls(); // mkdir
+
+                if(!QDir().mkdir(destinationPath)){
+                    Instrumentation::addErrors();
+                    QMutexLocker locker(&resultMutex);
+                    result.errors << CopyFileError{currFileInfo.absoluteFilePath(), destinationPath, "Couldn't create the destination folder."};
+                    continue;
+                }
+
+                pendingFolders << qMakePair(currFileInfo.absoluteFilePath(), destinationPath);
+            }
+        }
+    }
+
+    workers.waitForDone();
+
+    // the walk stops with folders still pending when canceled
+    result.wasCanceled = wasFileSkipped || !pendingFolders.isEmpty();
+
+    return result;
+}
+
+bool rmDir(const QString &dirPath){
+    return rmDir(dirPath, RmDirOptions()).success();
+}
+
+namespace {
+
+#ifdef Q_OS_UNIX
+// A folder being removed. It is only rmdir'ed after its own scan and all its subfolders are done.
+// Its fd stays open until then, the subfolders are opened and removed by name relative to it.
+struct RemoveNode{
+    RemoveNode *parent;
+    QByteArray name;
+    QByteArray path; // relative to RemoveTree::baseFd, for the errors
+    int depth;
+    DIR *dir;
+    std::atomic<int> pending; // own scan + subfolders not yet removed
+    std::atomic<bool> failed; // something inside couldn't be removed, so don't try to rmdir it
+    bool rescanned;
+
+    RemoveNode(RemoveNode *parent, const QByteArray &name) : parent(parent), name(name), path(parent != nullptr ? parent->path + "/" + name : name),
+        depth(parent != nullptr ? parent->depth + 1 : 0), dir(nullptr), pending(1), failed(false), rescanned(false){}
+};
+
+// Removes a folder tree using fd relative calls (openat / unlinkat), handing subfolders to idle workers
+class RemoveTree{
+public:
+    RemoveTree(const int baseFd, const RmDirOptions &options) : baseFd(baseFd), options(options), maxOpenFolders(openFoldersLimit()), entriesFound(0), entriesRemoved(0), openFolders(0){
+        workers.setMaxThreadCount(resolveThreadCount(options.maxThreads));
+    }
+
+    void run(const QByteArray &rootName, RmDirResult &result){
+        removeNode(new RemoveNode(nullptr, rootName));
+        workers.waitForDone();
+
+        result.entriesRemoved += entriesRemoved;
+        result.errors << errors;
+    }
+
+private:
+    // each level keeps a folder open (and a stack frame), deeper folders are left with an error
+    static const int maxDepth = 256;
+
+    // half the fd limit, the other half is left to the rest of the program
+    static int openFoldersLimit(){
+        struct rlimit fdLimit;
+
+        if(::getrlimit(RLIMIT_NOFILE, &fdLimit) != 0 || fdLimit.rlim_cur == RLIM_INFINITY){
+            return 4096;
+        }
+
+        return int(qBound(rlim_t(maxDepth), fdLimit.rlim_cur / 2, rlim_t(4096)));
+    }
+
+    void reportProgress(){
+        if(options.progress){
+            QMutexLocker locker(&progressMutex);
+            options.progress(entriesRemoved, entriesFound + 1); // + the root folder
+        }
+    }
+
+    void addError(const QByteArray &path, const QString &errorString){
+        Instrumentation::addErrors();
+        QMutexLocker locker(&errorsMutex);
+        errors << RmDirError{QFile::decodeName(path), errorString};
+    }
+
+    void addError(const QByteArray &path, const int errorNumber){
+        addError(path, qt_error_string(errorNumber));
+    }
+
+    int parentFd(const RemoveNode *node) const{
+        return node->parent != nullptr ? ::dirfd(node->parent->dir) : baseFd;
+    }
+
+    void closeNode(RemoveNode *node){
+        if(node->dir != nullptr){
+            ::closedir(node->dir);
+            node->dir = nullptr;
+            openFolders--;
+        }
+    }
+
+    void removeNode(RemoveNode *node){
+        if(node->depth > maxDepth){
+            addError(node->path, QString("Folder tree deeper than %1 levels.").arg(maxDepth));
+            node->failed = true;
+            finishNode(node);
+            return;
+        }
+
+        // symlinks are never followed (a symlinked root folder is removed by rmDir itself)
+        Instrumentation::addSyscalls(2); // openat, closedir
+
+        const int dirFd = ::openat(parentFd(node), node->name.constData(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        node->dir = dirFd != -1 ? ::fdopendir(dirFd) : nullptr;
+
+        if(node->dir == nullptr){
+            addError(node->path, errno);
+            if(dirFd != -1){
+                ::close(dirFd);
+            }
+            node->failed = true;
+            finishNode(node);
+            return;
+        }
+
+        openFolders++;
+
+        while(struct dirent *entry = ::readdir(node->dir)){
+
+            if(options.isCanceled && options.isCanceled()){
+                node->failed = true; // not empty, so don't try to remove it
+                break;
+            }
+
+            const char *name = entry->d_name;
+
+            if(name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))){
+                continue;
+            }
+
+            bool isDir = entry->d_type == DT_DIR;
+
+            Instrumentation::addFilesVisited();
+            entriesFound++;
+
+            if(entry->d_type == DT_UNKNOWN){ // some filesystems don't fill d_type
+                Instrumentation::addSyscalls();
+                struct stat entryStat;
+                isDir = ::fstatat(dirFd, name, &entryStat, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(entryStat.st_mode);
+            }
+
+            if(!isDir){
+                Instrumentation::addSyscalls();
+                if(::unlinkat(dirFd, name, 0) == 0){
+                    entriesRemoved++;
+                    reportProgress();
+                }
+                else{
+                    addError(node->path + "/" + name, errno);
+                    node->failed = true;
+                }
+                continue;
+            }
+
+            RemoveNode *child = new RemoveNode(node, name);
+            node->pending++;
+
+            // fan out while there are idle workers and fds to spare, otherwise just go depth first in this thread
+            if(workers.activeThreadCount() < workers.maxThreadCount() && openFolders < maxOpenFolders - maxDepth){
+                workers.start(new FunctionRunnable([this, child](){
+                    removeNode(child);
+                }));
+            }
+            else{
+                removeNode(child);
+            }
+        }
+
+        // still open, the subfolders handed to the workers use it
+        finishNode(node);
+    }
+
+    void finishNode(RemoveNode *node){
+        if(--node->pending > 0){
+            return;
+        }
+
+        closeNode(node);
+
+        if(!node->failed){
+            Instrumentation::addSyscalls();
+            if(::unlinkat(parentFd(node), node->name.constData(), AT_REMOVEDIR) == 0){
+                entriesRemoved++;
+                reportProgress();
+            }
+            else if(errno == ENOTEMPTY && !node->rescanned){
+                // some filesystems skip entries when they are removed during readdir, so give it a second pass
+                node->rescanned = true;
+                node->pending = 1;
+                removeNode(node);
+                return;
+            }
+            else{
+                addError(node->path, errno);
+                node->failed = true;
+            }
+        }
+
+        RemoveNode *parent = node->parent;
+
+        if(parent != nullptr && node->failed){
+            parent->failed = true;
+        }
+
+        delete node;
+
+        if(parent != nullptr){
+            finishNode(parent);
+        }
+    }
+
+    const int baseFd;
+    const RmDirOptions &options;
+    const int maxOpenFolders;
+    QThreadPool workers;
+    std::atomic<qint64> entriesFound;
+    std::atomic<qint64> entriesRemoved;
+    std::atomic<int> openFolders;
+    QMutex progressMutex;
+    QMutex errorsMutex;
+    QList<RmDirError> errors;
+};
+#else
+// Based from here: http://stackoverflow.com/questions/2536524/copy-directory-using-qt (ty roop)
+void removeDirRecursively(const QString &dirPath, const RmDirOptions &options, RmDirResult &result){
+    QDir dir(dirPath);
+    for(const QFileInfo &info : dir.entryInfoList(QDir::Dirs | QDir::Files | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot)) {
+        if(options.isCanceled && options.isCanceled()){
+            return;
+        }
+        if (info.isDir() && !info.isSymLink()) {
+            removeDirRecursively(info.filePath(), options, result);
+        } else {
+            if (dir.remove(info.fileName()))
+                result.entriesRemoved++;
+            else
+                result.errors << RmDirError{info.filePath(), "Couldn't remove the file."};
+        }
+    }
+    QDir parentDir(QFileInfo(dirPath).path());
+    if(parentDir.rmdir(QFileInfo(dirPath).fileName()))
+        result.entriesRemoved++;
+    else
+        result.errors << RmDirError{dirPath, "Couldn't remove the folder."};
+}
+#endif
+
+}
+
+RmDirResult rmDir(const QString &dirPath, const RmDirOptions &options){
+    Instrumentation::ScopedPhase phase("rmDir");
+    RmDirResult result;
+    const QFileInfo dirInfo(QDir(dirPath).absolutePath()); // absolutePath also removes trailing slashes
+
+    if(dirInfo.isSymLink()){
+        // only the link is removed, never what it points to
+        QFile link(dirInfo.absoluteFilePath());
+
+        if(link.remove()){
+            result.entriesRemoved++;
+        }
+        else{
+            result.errors << RmDirError{dirInfo.absoluteFilePath(), link.errorString()};
+        }
+        return result;
+    }
+
+    if(!dirInfo.exists()){
+        return result;
+    }
+
+    QString pathToRemove = dirInfo.absoluteFilePath();
+
+    if(options.deleteInBackground){
+        // rename it first (same folder, so same filesystem), the caller can then reuse the original path right away
+        const QString backgroundPath = dirInfo.absolutePath() + "/." + dirInfo.fileName() + ".deleting." + QString::number(QDateTime::currentMSecsSinceEpoch(), 16);
+
+        if(QDir().rename(pathToRemove, backgroundPath)){
+            RmDirOptions backgroundOptions = options;
+            backgroundOptions.deleteInBackground = false;
+            // the call has already returned, nobody is left to cancel or follow it
+            backgroundOptions.isCanceled = nullptr;
+            backgroundOptions.progress = nullptr;
+
+            QThreadPool::globalInstance()->start(new FunctionRunnable([backgroundPath, backgroundOptions](){
+                rmDir(backgroundPath, backgroundOptions);
+            }));
+
+            result.backgroundPath = backgroundPath;
+            return result;
+        }
+        // couldn't rename, so just delete it right here
+    }
+
+#ifdef Q_OS_UNIX
+    const int baseFd = ::open(QFile::encodeName(dirInfo.absolutePath()).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if(baseFd == -1){
+        result.errors << RmDirError{dirInfo.absolutePath(), qt_error_string(errno)};
+        return result;
+    }
+
+    {
+        RemoveTree removeTree(baseFd, options);
+        removeTree.run(QFile::encodeName(dirInfo.fileName()), result);
+    }
+
+    ::close(baseFd);
+
+    // errors are relative to the parent folder, make them absolute
+    for(RmDirError &currError : result.errors){
+        currError.path = dirInfo.absolutePath() + "/" + currError.path;
+    }
+#else
+    removeDirRecursively(pathToRemove, options, result);
+#endif
+
+    result.wasCanceled = options.isCanceled && options.isCanceled();
+
+    return result;
+}
+
+namespace {
+
+// Applies the wildcard rules, e.g.:
+// *.xml -> *.xml
+// /myXmls/*.xml -> */myXmls/*.xml
+// myXmls\\file?.xml -> */myXmls/file?.xml
+QString formatWildcard(const QString &wildcard){
+    QString formattedWildcard = normalizePath(wildcard); // Convert slashes to work in both mac and windows
+
+    // if it doesn't start with any wildcard or a subdirectory slash, add a slash to beginning (so the file/folder matches at least the root folder)
+    if(!formattedWildcard.startsWith('/') && !formattedWildcard.startsWith('*') && !formattedWildcard.startsWith('?')){
+        formattedWildcard = "/" + formattedWildcard;
+    }
+
+    // if it is a subdirectory add * to match
+    if(formattedWildcard.startsWith('/')){
+        formattedWildcard = "*" + formattedWildcard;
+    }
+
+    return formattedWildcard;
+}
+
+// Literal text (ending with a slash) that every file matching the wildcard must have in its folder path
+// e.g. "/myXmls/*.xml" -> "/myXmls/", "/a*/b/*.xml" -> "/b/", "*.xml" -> ""
+QString wildcardRequiredFolderLiteral(const QString &wildcard){
+    const QString formattedWildcard = formatWildcard(wildcard);
+    const int lastSlash = formattedWildcard.lastIndexOf('/');
+    int literalStart = 0;
+
+    for(int i = 0; i < lastSlash; i++){
+        if(formattedWildcard.at(i) == '*' || formattedWildcard.at(i) == '?'){
+            literalStart = i + 1;
+        }
+    }
+
+    const QString literal = formattedWildcard.mid(literalStart, lastSlash - literalStart + 1);
+
+    return literal.size() > 1 ? literal : QString(); // a single slash is always there
+}
+
+}
+
+// Supports wildcards, and subdirectories with wildcard e.g.:
+// *.xml
+// /myXmls/*.xml
+//
+// Each wildcard is a sequence of positions (a literal char, ? or *) and all of them are simulated together
+// as a bit set of active positions (shift-and), so a path is read only once whatever the number of wildcards.
+// Like the regular expression it replaces, * and ? match any char but a line feed,
+// and a single line feed at the end of the path is ignored.
+WildcardMatcher::WildcardMatcher(){
+    compile(QStringList());
+}
+
+WildcardMatcher::WildcardMatcher(const QString &wildcard){
+    compile(QStringList() << wildcard);
+}
+
+WildcardMatcher::WildcardMatcher(const QStringList &wildcards){
+    compile(wildcards);
+}
+
+void WildcardMatcher::compile(const QStringList &wildcards){
+
+    // tokens for * and ? (code points never go that high)
+    const uint starToken = 0xFFFFFFFF;
+    const uint anyToken = 0xFFFFFFFE;
+
+    QVector<QVector<uint>> tokens;
+
+    for(const QString &currWildcard : wildcards){
+        QVector<uint> currTokens;
+
+        if(!currWildcard.trimmed().isEmpty()){
+            const QVector<uint> codePoints = formatWildcard(currWildcard).toUcs4();
+
+            for(const uint currCodePoint : codePoints){
+                if(currCodePoint == '*'){
+                    if(currTokens.isEmpty() || currTokens.last() != starToken){ // ** is the same as *
+                        currTokens << starToken;
+                    }
+                }
+                else{
+                    currTokens << (currCodePoint == '?' ? anyToken : currCodePoint);
+                }
+            }
+        }
+
+        tokens << currTokens;
+    }
+
+    // one position per token plus the accepting one, for each wildcard
+    int totalPositions = 0;
+
+    for(const QVector<uint> &currTokens : tokens){
+        totalPositions += currTokens.size() + 1;
+    }
+
+    stateWords = (totalPositions + 63) / 64;
+    starMask.assign(stateWords, 0);
+    initialStates.assign(stateWords, 0);
+    acceptStates.assign(stateWords, 0);
+    acceptPositions.clear();
+
+    // row 0: chars not used in any wildcard (only ? moves on), row 1: line feed (? doesn't match it)
+    rows.assign(2 * stateWords, 0);
+    std::fill(asciiRows, asciiRows + 128, 0);
+    asciiRows['\n'] = 1;
+    otherRows.clear();
+
+    auto setBit = [](std::vector<quint64> &bits, const int offset, const int position){
+        bits[offset + position / 64] |= quint64(1) << (position % 64);
+    };
+
+    int currPosition = 0;
+
+    for(const QVector<uint> &currTokens : tokens){
+        if(currTokens.isEmpty()){ // empty wildcards never match
+            acceptPositions.push_back(-1);
+            currPosition++;
+            continue;
+        }
+
+        setBit(initialStates, 0, currPosition);
+
+        for(const uint currToken : currTokens){
+            if(currToken == starToken){
+                setBit(starMask, 0, currPosition);
+            }
+            else if(currToken == anyToken){
+                setBit(rows, 0, currPosition);
+            }
+            currPosition++;
+        }
+
+        setBit(acceptStates, 0, currPosition);
+        acceptPositions.push_back(currPosition);
+        currPosition++;
+    }
+
+    // a row for each literal char, which also includes the ? positions (row 0)
+    auto rowFor = [this](const uint codePoint) -> int{
+        int *existingRow = codePoint < 128 ? &asciiRows[codePoint] : nullptr;
+        int rowIndex = existingRow != nullptr ? *existingRow : otherRows.value(codePoint, 0);
+
+        if(rowIndex == 0){
+            rowIndex = int(rows.size()) / stateWords;
+            rows.resize(rows.size() + stateWords);
+            std::copy(rows.begin(), rows.begin() + stateWords, rows.begin() + rowIndex * stateWords);
+
+            if(existingRow != nullptr){
+                *existingRow = rowIndex;
+            }
+            else{
+                otherRows.insert(codePoint, rowIndex);
+            }
+        }
+
+        return rowIndex;
+    };
+
+    currPosition = 0;
+
+    for(const QVector<uint> &currTokens : tokens){
+        for(const uint currToken : currTokens){
+            if(currToken != starToken && currToken != anyToken){
+                setBit(rows, rowFor(currToken) * stateWords, currPosition);
+            }
+            currPosition++;
+        }
+        currPosition++;
+    }
+
+    // positions right after a * are also active when the * is (it may match nothing)
+    for(int i = 0; i < stateWords; i++){
+        initialStates[i] |= (initialStates[i] & starMask[i]) << 1 | (i > 0 ? (initialStates[i - 1] & starMask[i - 1]) >> 63 : 0);
+    }
+}
+
+bool WildcardMatcher::isEmpty() const{
+    for(const int currAcceptPosition : acceptPositions){
+        if(currAcceptPosition != -1){
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WildcardMatcher::matches(const QString &filePath) const{
+    return matchIndex(filePath) != -1;
+}
+
+int WildcardMatcher::matchIndex(const QString &filePath) const{
+    if(isEmpty()){
+        return -1;
+    }
+
+    QVarLengthArray<quint64, 8> states(stateWords);
+    QVarLengthArray<quint64, 8> acceptedBeforeLineFeed(stateWords);
+    std::copy(initialStates.begin(), initialStates.end(), states.begin());
+    std::fill(acceptedBeforeLineFeed.begin(), acceptedBeforeLineFeed.end(), 0);
+
+    const QChar *data = filePath.constData();
+    const int size = filePath.size();
+
+    for(int i = 0; i < size; i++){
+        uint codePoint = data[i].unicode();
+
+        if(QChar::isHighSurrogate(codePoint) && i + 1 < size && data[i + 1].isLowSurrogate()){
+            codePoint = QChar::surrogateToUcs4(data[i], data[i + 1]);
+            i++;
+        }
+
+        const bool isLineFeed = codePoint == '\n';
+
+        if(isLineFeed && i == size - 1){ // '$' also matches before a final line feed
+            for(int w = 0; w < stateWords; w++){
+                acceptedBeforeLineFeed[w] = states[w] & acceptStates[w];
+            }
+        }
+
+        const quint64 *row = &rows[(codePoint < 128 ? asciiRows[codePoint] : otherRows.value(codePoint, 0)) * stateWords];
+        quint64 carry = 0;
+        quint64 starCarry = 0;
+        quint64 anyActive = 0;
+
+        for(int w = 0; w < stateWords; w++){
+            // move on from positions that accept this char, and stay on the * ones
+            const quint64 advancing = states[w] & row[w];
+            quint64 next = (advancing << 1) | carry | (isLineFeed ? 0 : states[w] & starMask[w]);
+            carry = advancing >> 63;
+
+            // positions after an active * are active too
+            const quint64 activeStars = next & starMask[w];
+            next |= (activeStars << 1) | starCarry;
+            starCarry = activeStars >> 63;
+
+            states[w] = next;
+            anyActive |= next;
+        }
+
+        if(anyActive == 0 && i != size - 1){
+            return -1;
+        }
+    }
+
+    for(int currWildcard = 0; currWildcard < int(acceptPositions.size()); currWildcard++){
+        const int currAcceptPosition = acceptPositions[currWildcard];
+
+        if(currAcceptPosition == -1){
+            continue;
+        }
+
+        const int word = currAcceptPosition / 64;
+        const quint64 bit = quint64(1) << (currAcceptPosition % 64);
+
+        if(((states[word] | acceptedBeforeLineFeed[word]) & bit) != 0){
+            return currWildcard;
+        }
+    }
+
+    return -1;
+}
+
+struct WildcardFileIterator::Private{
+    struct Folder{
+        std::unique_ptr<QDirIterator> iterator;
+        bool canMatch; // whether files in this folder can match the wildcard at all
+    };
+
+    WildcardMatcher matcher;
+    QString requiredFolderLiteral;
+    bool isRecursive;
+    std::vector<Folder> pendingFolders; // current path in the tree, so memory doesn't grow with the tree size
+    QString nextFile;
+    bool hasNextFile = false;
+
+    void pushFolder(const QString &folderPath, const bool parentCanMatch){
+        Folder folder;
+        folder.iterator.reset(new QDirIterator(folderPath, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot));
+        folder.canMatch = parentCanMatch || (folderPath + "/").contains(requiredFolderLiteral);
+        pendingFolders.push_back(std::move(folder));
+    }
+
+    // Walks until the next matching file (or the end of the tree)
+    void advance(){
+        hasNextFile = false;
+
+        while(!pendingFolders.empty()){
+
+            Folder &currFolder = pendingFolders.back();
+
+            if(!currFolder.iterator->hasNext()){
+                pendingFolders.pop_back();
+                continue;
+            }
+
+            const QString currPath = currFolder.iterator->next();
+            const QFileInfo currFileInfo = currFolder.iterator->fileInfo();
+
+            Instrumentation::addFilesVisited();
+
+            if(currFileInfo.isDir()){
+                // like QDirIterator::Subdirectories: no hidden folders (filtered above) and no symlinks
+                if(isRecursive && !currFileInfo.isSymLink()){
+                    pushFolder(currPath, currFolder.canMatch); // go depth first
+                }
+            }
+            else if(currFolder.canMatch && matcher.matches(currPath)){
+                nextFile = currPath;
+                hasNextFile = true;
+                return;
+            }
+        }
+    }
+};
+
+WildcardFileIterator::WildcardFileIterator(const QString &entryFolder, const QString &wildcard, bool isRecursive) : d(new Private){
+    d->isRecursive = isRecursive;
+
+    if(wildcard.trimmed().isEmpty()){
+        return;
+    }
+
+    d->matcher = WildcardMatcher(wildcard);
+    d->requiredFolderLiteral = wildcardRequiredFolderLiteral(wildcard);
+    d->pushFolder(entryFolder, d->requiredFolderLiteral.isEmpty());
+    d->advance();
+}
+
+WildcardFileIterator::~WildcardFileIterator() = default;
+
+bool WildcardFileIterator::hasNext() const{
+    return d->hasNextFile;
+}
+
+QString WildcardFileIterator::next(){
+    const QString currFile = d->nextFile;
+    d->advance();
+    return currFile;
+}
+
+// Gets all files from a folder filtered by a given wildcard
+QStringList getFolderFilesByWildcard(const QString &entryFolder, const QString &wildcard, bool isRecursive){
+
+    Instrumentation::ScopedPhase phase("getFolderFilesByWildcard");
+    QStringList filesFound; // result files with absolute path
+
+    WildcardFileIterator it(entryFolder, wildcard, isRecursive);
+
+    while (it.hasNext()){
+        filesFound << it.next();
+    }
+
+    return filesFound;
+}
+
+// Calls callback for each matching file while the folder is walked, stops when callback returns false
+// Returns false if it was stopped by the callback
+bool forEachFileByWildcard(const QString &entryFolder, const QString &wildcard, bool isRecursive, const std::function<bool(const QString &filePath)> &callback){
+
+    Instrumentation::ScopedPhase phase("forEachFileByWildcard");
+
+    WildcardFileIterator it(entryFolder, wildcard, isRecursive);
+
+    while (it.hasNext()){
+        if(!callback(it.next())){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QStringList filterFilesByWildcard(const QStringList &filePaths, const QString &wildcard){
+    return filterFilesByWildcard(filePaths, WildcardMatcher(wildcard));
+}
+
+// Files matching any of the wildcards
+QStringList filterFilesByWildcard(const QStringList &filePaths, const QStringList &wildcards){
+    return filterFilesByWildcard(filePaths, WildcardMatcher(wildcards));
+}
+
+QStringList filterFilesByWildcard(const QStringList &filePaths, const WildcardMatcher &matcher){
+    Instrumentation::ScopedPhase phase("filterFilesByWildcard");
+    QStringList resultFiles;
+
+    if(matcher.isEmpty()){
+        return resultFiles;
+    }
+
+    for(const QString &currentFile : filePaths){
+
+        if(matcher.matches(currentFile)){
+            resultFiles << currentFile;
+        }
+
+    }
+
+    return resultFiles;
+}
+
+struct FileIndex::Private{
+    FileIndex *q;
+    QString rootPath;
+
+    mutable QReadWriteLock lock;
+    QHash<QString, QSet<QString>> folderFiles; // folder path -> file names
+    QHash<QString, QSet<QString>> folderSubfolders; // folder path -> subfolder names
+
+    int inotifyFd = -1;
+    QSocketNotifier *inotifyNotifier = nullptr;
+    QHash<int, QString> watchFolders; // inotify watch -> folder path
+    QHash<QString, int> folderWatches;
+    QFileSystemWatcher *watcher = nullptr; // when inotify isn't available
+    QSet<QString> unwatchedFolders; // couldn't be watched (e.g. out of inotify watches), reported once with overflowed
+
+    static bool isHidden(const QString &name){
+        return name.startsWith('.'); // same as QFileInfo::isHidden in unix
+    }
+
+    void watchFolder(const QString &folderPath){
+        bool isWatched;
+
+#ifdef Q_OS_LINUX
+        if(inotifyFd != -1){
+            const int watch = ::inotify_add_watch(inotifyFd, QFile::encodeName(folderPath).constData(),
+                                                  IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW);
+            if(watch != -1){
+                watchFolders.insert(watch, folderPath);
+                folderWatches.insert(folderPath, watch);
+            }
+            // already gone, its parent reports the removal
+            isWatched = watch != -1 || errno == ENOENT || errno == ENOTDIR;
+        }
+        else
+#endif
+        {
+            isWatched = watcher->addPath(folderPath) || !QFileInfo(folderPath).isDir();
+        }
+
+        if(isWatched){
+            unwatchedFolders.remove(folderPath);
+        }
+        // changes there would be missed silently, the user can still resync when it makes sense
+        // (only once per folder, so a resync failing again doesn't loop)
+        else if(!unwatchedFolders.contains(folderPath)){
+            unwatchedFolders.insert(folderPath);
+            QMetaObject::invokeMethod(q, "overflowed", Qt::QueuedConnection);
+        }
+    }
+
+    void unwatchFolder(const QString &folderPath){
+#ifdef Q_OS_LINUX
+        if(inotifyFd != -1){
+            const int watch = folderWatches.take(folderPath);
+            if(watch != 0 && watchFolders.remove(watch) > 0){
+                ::inotify_rm_watch(inotifyFd, watch);
+            }
+            return;
+        }
+#endif
+        watcher->removePath(folderPath);
+    }
+
+    // Same entries as getFolderFilesByWildcard: no hidden files / folders, folder symlinks not followed
+    // The folder is watched before it is listed, so nothing created meanwhile is missed
+    void scanFolder(const QString &folderPath, QStringList *addedFiles){
+        watchFolder(folderPath);
+
+        QSet<QString> files;
+        QSet<QString> subfolders;
+
+        for(const QFileInfo &currFileInfo : QDir(folderPath).entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot)){
+            if(currFileInfo.isDir()){
+                if(!currFileInfo.isSymLink()){
+                    subfolders.insert(currFileInfo.fileName());
+                }
+            }
+            else{
+                files.insert(currFileInfo.fileName());
+            }
+        }
+
+        {
+            QWriteLocker locker(&lock);
+            folderFiles.insert(folderPath, files);
+            folderSubfolders.insert(folderPath, subfolders);
+        }
+
+        if(addedFiles != nullptr){
+            for(const QString &currFile : files){
+                *addedFiles << folderPath + "/" + currFile;
+            }
+        }
+
+        for(const QString &currSubfolder : subfolders){
+            scanFolder(folderPath + "/" + currSubfolder, addedFiles);
+        }
+    }
+
+    void removeFolder(const QString &folderPath, QStringList &removedFiles){
+        QSet<QString> files;
+        QSet<QString> subfolders;
+
+        {
+            QWriteLocker locker(&lock);
+            files = folderFiles.take(folderPath);
+            subfolders = folderSubfolders.take(folderPath);
+        }
+
+        unwatchFolder(folderPath);
+        unwatchedFolders.remove(folderPath);
+
+        for(const QString &currFile : files){
+            removedFiles << folderPath + "/" + currFile;
+        }
+
+        for(const QString &currSubfolder : subfolders){
+            removeFolder(folderPath + "/" + currSubfolder, removedFiles);
+        }
+    }
+
+    // An entry of an indexed folder was created / changed / removed
+    void updateEntry(const QString &folderPath, const QString &name, const bool isDirEvent, const bool wasRemoved, const bool wasWritten){
+        if(isHidden(name)){
+            return;
+        }
+
+        const QString entryPath = folderPath + "/" + name;
+        QStringList addedFiles, removedFiles, modifiedFiles;
+
+        if(isDirEvent){
+            bool isKnown;
+            {
+                QWriteLocker locker(&lock);
+                auto it = folderSubfolders.find(folderPath);
+                if(it == folderSubfolders.end()){
+                    return; // not indexed (anymore)
+                }
+                isKnown = it->contains(name);
+                if(wasRemoved){
+                    it->remove(name);
+                }
+                else{
+                    it->insert(name);
+                }
+            }
+
+            if(isKnown){
+                removeFolder(entryPath, removedFiles);
+            }
+            if(!wasRemoved){
+                scanFolder(entryPath, &addedFiles);
+            }
+        }
+        else{
+            const QFileInfo entryInfo(entryPath);
+            const bool isFile = !wasRemoved && entryInfo.exists() && !entryInfo.isDir();
+
+            QWriteLocker locker(&lock);
+            auto it = folderFiles.find(folderPath);
+
+            if(it == folderFiles.end()){
+                return;
+            }
+
+            if(isFile){
+                if(!it->contains(name)){
+                    it->insert(name);
+                    addedFiles << entryPath;
+                }
+                else if(wasWritten){
+                    modifiedFiles << entryPath;
+                }
+            }
+            else if(it->remove(name)){
+                removedFiles << entryPath;
+            }
+        }
+
+        emitChanges(addedFiles, removedFiles, modifiedFiles);
+    }
+
+    void emitChanges(const QStringList &addedFiles, const QStringList &removedFiles, const QStringList &modifiedFiles){
+        for(const QString &currFile : removedFiles){
+            emit q->fileRemoved(currFile);
+        }
+        for(const QString &currFile : addedFiles){
+            emit q->fileAdded(currFile);
+        }
+        for(const QString &currFile : modifiedFiles){
+            emit q->fileModified(currFile);
+        }
+    }
+};
+
+// Does the initial scan right away. Needs an event loop running in its thread to be kept up to date.
+FileIndex::FileIndex(const QString &rootPath, QObject *parent) : QObject(parent), d(new Private){
+    d->q = this;
+    d->rootPath = QDir::cleanPath(rootPath);
+
+#ifdef Q_OS_LINUX
+    d->inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if(d->inotifyFd != -1){
+        d->inotifyNotifier = new QSocketNotifier(d->inotifyFd, QSocketNotifier::Read, this);
+        // string based, activated is overloaded in Qt 5.15
+        connect(d->inotifyNotifier, SIGNAL(activated(int)), this, SLOT(readInotifyEvents()));
+    }
+#endif
+
+    if(d->inotifyFd == -1){
+        d->watcher = new QFileSystemWatcher(this);
+        connect(d->watcher, &QFileSystemWatcher::directoryChanged, this, &FileIndex::folderChanged);
+    }
+
+    d->scanFolder(d->rootPath, nullptr);
+}
+
+FileIndex::~FileIndex(){
+#ifdef Q_OS_LINUX
+    if(d->inotifyFd != -1){
+        delete d->inotifyNotifier; // before closing its fd
+        ::close(d->inotifyFd);
+    }
+#endif
+}
+
+QString FileIndex::rootPath() const{
+    return d->rootPath;
+}
+
+bool FileIndex::isUsingInotify() const{
+    return d->inotifyFd != -1;
+}
+
+int FileIndex::fileCount() const{
+    QReadLocker locker(&d->lock);
+    int count = 0;
+
+    for(const QSet<QString> &currFiles : d->folderFiles){
+        count += currFiles.size();
+    }
+
+    return count;
+}
+
+// Same results as getFolderFilesByWildcard(rootPath(), wildcard, isRecursive), without touching the disk
+// Can be called from any thread
+QStringList FileIndex::filesByWildcard(const QString &wildcard, bool isRecursive) const{
+    if(wildcard.trimmed().isEmpty()){
+        return QStringList();
+    }
+
+    const WildcardMatcher matcher(wildcard);
+    const QString requiredFolderLiteral = wildcardRequiredFolderLiteral(wildcard);
+    QStringList result;
+
+    QReadLocker locker(&d->lock);
+
+    for(auto it = d->folderFiles.constBegin(); it != d->folderFiles.constEnd(); ++it){
+
+        if(!isRecursive && it.key() != d->rootPath){
+            continue;
+        }
+
+        if(!requiredFolderLiteral.isEmpty() && !(it.key() + "/").contains(requiredFolderLiteral)){
+            continue; // nothing in this folder can match
+        }
+
+        for(const QString &currFile : it.value()){
+            const QString currPath = it.key() + "/" + currFile;
+            if(matcher.matches(currPath)){
+                result << currPath;
+            }
+        }
+    }
+
+    return result;
+}
+
+// Rescans the whole tree (e.g. after overflowed), emitting the differences found
+void FileIndex::resync(){
+    QHash<QString, QSet<QString>> oldFolderFiles;
+
+    {
+        QReadLocker locker(&d->lock);
+        oldFolderFiles = d->folderFiles;
+    }
+
+    const QStringList oldFolders = oldFolderFiles.keys();
+
+    for(const QString &currFolder : oldFolders){
+        d->unwatchFolder(currFolder);
+    }
+
+    {
+        QWriteLocker locker(&d->lock);
+        d->folderFiles.clear();
+        d->folderSubfolders.clear();
+    }
+
+    d->scanFolder(d->rootPath, nullptr);
+
+    QStringList addedFiles, removedFiles;
+
+    {
+        QReadLocker locker(&d->lock);
+
+        for(auto it = d->folderFiles.constBegin(); it != d->folderFiles.constEnd(); ++it){
+            const QSet<QString> oldFiles = oldFolderFiles.value(it.key());
+            for(const QString &currFile : it.value()){
+                if(!oldFiles.contains(currFile)){
+                    addedFiles << it.key() + "/" + currFile;
+                }
+            }
+        }
+
+        for(auto it = oldFolderFiles.constBegin(); it != oldFolderFiles.constEnd(); ++it){
+            const QSet<QString> newFiles = d->folderFiles.value(it.key());
+            for(const QString &currFile : it.value()){
+                if(!newFiles.contains(currFile)){
+                    removedFiles << it.key() + "/" + currFile;
+                }
+            }
+        }
+    }
+
+    d->emitChanges(addedFiles, removedFiles, QStringList());
+
+    emit resynced();
+}
+
+void FileIndex::readInotifyEvents(){
+#ifdef Q_OS_LINUX
+    alignas(struct inotify_event) char buffer[64 * 1024];
+    bool hasOverflowed = false;
+
+    while(true){
+        const ssize_t bytesRead = ::read(d->inotifyFd, buffer, sizeof(buffer));
+
+        if(bytesRead <= 0){ // EAGAIN, nothing else to read
+            break;
+        }
+
+        for(char *curr = buffer; curr < buffer + bytesRead;){
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>(curr);
+            curr += sizeof(struct inotify_event) + event->len;
+
+            if(event->mask & IN_Q_OVERFLOW){
+                hasOverflowed = true;
+                continue;
+            }
+
+            if(event->mask & IN_IGNORED){
+                const QString folderPath = d->watchFolders.take(event->wd);
+                d->folderWatches.remove(folderPath);
+                continue;
+            }
+
+            const QString folderPath = d->watchFolders.value(event->wd);
+
+            if(folderPath.isEmpty()){
+                continue;
+            }
+
+            if(event->len == 0){ // the watched folder itself
+                if((event->mask & IN_DELETE_SELF) && folderPath == d->rootPath){
+                    QStringList removedFiles;
+                    d->removeFolder(d->rootPath, removedFiles);
+                    d->emitChanges(QStringList(), removedFiles, QStringList());
+                }
+                continue; // the others are handled by the parent folder events
+            }
+
+            d->updateEntry(folderPath, QFile::decodeName(event->name), event->mask & IN_ISDIR,
+                           event->mask & (IN_DELETE | IN_MOVED_FROM), event->mask & IN_CLOSE_WRITE);
+        }
+    }
+
+    if(hasOverflowed){
+        emit overflowed();
+    }
+#endif
+}
+
+// QFileSystemWatcher fallback: compare the folder entries with the index
+void FileIndex::folderChanged(const QString &folderPath){
+    QSet<QString> oldFiles, oldSubfolders;
+
+    {
+        QReadLocker locker(&d->lock);
+        if(!d->folderFiles.contains(folderPath)){
+            return;
+        }
+        oldFiles = d->folderFiles.value(folderPath);
+        oldSubfolders = d->folderSubfolders.value(folderPath);
+    }
+
+    if(!QFileInfo(folderPath).isDir()){
+        // removed, its parent will also report the change, but the root has no parent
+        if(folderPath == d->rootPath){
+            QStringList removedFiles;
+            d->removeFolder(d->rootPath, removedFiles);
+            d->emitChanges(QStringList(), removedFiles, QStringList());
+        }
+        return;
+    }
+
+    QSet<QString> currFiles, currSubfolders;
+
+    for(const QFileInfo &currFileInfo : QDir(folderPath).entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot)){
+        if(currFileInfo.isDir()){
+            if(!currFileInfo.isSymLink()){
+                currSubfolders.insert(currFileInfo.fileName());
+            }
+        }
+        else{
+            currFiles.insert(currFileInfo.fileName());
+        }
+    }
+
+    for(const QString &currFile : currFiles - oldFiles){
+        d->updateEntry(folderPath, currFile, false, false, false);
+    }
+    for(const QString &currFile : oldFiles - currFiles){
+        d->updateEntry(folderPath, currFile, false, true, false);
+    }
+    for(const QString &currSubfolder : currSubfolders - oldSubfolders){
+        d->updateEntry(folderPath, currSubfolder, true, false, false);
+    }
+    for(const QString &currSubfolder : oldSubfolders - currSubfolders){
+        d->updateEntry(folderPath, currSubfolder, true, true, false);
+    }
+}
+
+namespace {
+
+// Hashes the whole file with big reads
+// It isn't mapped in memory: a mapped file truncated by another process while it is hashed kills us with SIGBUS,
+// while read() just returns less data (and with 1 MiB reads the syscalls cost little next to the hashing)
+// Based from here: http://www.qtcentre.org/archive/index.php/t-35674.html (thanks wysota!)
+bool hashFileContents(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm, QByteArray &hash, QString &errorString, const std::function<bool()> &isCanceled = nullptr){
+
+    Instrumentation::ScopedPhase phase("fileHash");
+    Instrumentation::addFilesVisited();
+    Instrumentation::addSyscalls(); // open
+
+    QCryptographicHash crypto(hashAlgorithm);
+    QFile file(fileName);
+
+    if(!file.open(QFile::ReadOnly)){
+        Instrumentation::addErrors();
+        errorString = file.errorString();
+        return false;
+    }
+
+    QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+
+    while(true){
+        if(isCanceled && isCanceled()){
+            errorString = "Canceled.";
+            return false;
+        }
+
+        const qint64 bytesRead = file.read(buffer.data(), buffer.size());
+        Instrumentation::addSyscalls();
+
+        if(bytesRead < 0){
+            Instrumentation::addErrors();
+            errorString = file.errorString();
+            return false;
+        }
+
+        if(bytesRead == 0){
+            break;
+        }
+
+        crypto.addData(buffer.constData(), int(bytesRead));
+        Instrumentation::addBytesRead(bytesRead);
+    }
+
+    hash = crypto.result();
+    return true;
+}
+
+}
+
+// Returns empty QString on failure.
+QString fileHash(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm)
+{
+    QByteArray hash;
+    QString errorString;
+
+    if(!hashFileContents(fileName, hashAlgorithm, hash, errorString)){
+        return QString();
+    }
+
+    return QString(hash.toHex());
+}
+
+// Hashes the files concurrently, results are in the same order as fileNames
+// onResult (optional) gets each result as soon as it's ready, it is called from the worker threads (one call at a time)
+QVector<FileHashResult> fileHashes(const QStringList &fileNames, QCryptographicHash::Algorithm hashAlgorithm, const std::function<void(const FileHashResult &result)> &onResult, int maxThreads){
+
+    QVector<FileHashResult> results(fileNames.size());
+    FileHashResult *resultsData = results.data(); // detach now, each worker writes only its own entries
+
+    QMutex onResultMutex;
+
+    parallelFor(fileNames.size(), maxThreads, [&](const int i){
+        FileHashResult &currResult = resultsData[i];
+        QByteArray hash;
+
+        currResult.fileName = fileNames.at(i);
+
+        if(hashFileContents(currResult.fileName, hashAlgorithm, hash, currResult.errorString)){
+            currResult.hash = QString(hash.toHex());
+        }
+        else if(currResult.errorString.isEmpty()){
+            currResult.errorString = "Couldn't read the file.";
+        }
+
+        if(onResult){
+            QMutexLocker locker(&onResultMutex);
+            onResult(currResult);
+        }
+    });
+
+    return results;
+}
+
+namespace {
+
+struct FileIdentity{
+    qint64 size = -1;
+    qint64 modificationTime = 0; // nanoseconds since epoch
+    qint64 changeTime = 0; // nanoseconds since epoch, inode change (0 if unknown)
+    quint64 inode = 0;
+
+    bool operator==(const FileIdentity &other) const{
+        return size == other.size && modificationTime == other.modificationTime && changeTime == other.changeTime && inode == other.inode;
+    }
+};
+
+bool getFileIdentity(const QString &fileName, FileIdentity &identity){
+#ifdef Q_OS_UNIX
+    struct stat fileStat;
+
+    if(::stat(QFile::encodeName(fileName).constData(), &fileStat) == -1 || !S_ISREG(fileStat.st_mode)){
+        return false;
+    }
+
+    identity.size = fileStat.st_size;
+    identity.inode = fileStat.st_ino;
+    // the change time also moves when the file is rewritten and its modification time set back (touch -r, rsync -t...)
+#if defined(Q_OS_LINUX)
+    identity.modificationTime = qint64(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+    identity.changeTime = qint64(fileStat.st_ctim.tv_sec) * 1000000000 + fileStat.st_ctim.tv_nsec;
+#elif defined(Q_OS_MAC)
+    identity.modificationTime = qint64(fileStat.st_mtimespec.tv_sec) * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+    identity.changeTime = qint64(fileStat.st_ctimespec.tv_sec) * 1000000000 + fileStat.st_ctimespec.tv_nsec;
+#else
+    identity.modificationTime = qint64(fileStat.st_mtime) * 1000000000;
+    identity.changeTime = qint64(fileStat.st_ctime) * 1000000000;
+#endif
+    return true;
+#else
+    const QFileInfo fileInfo(fileName);
+
+    if(!fileInfo.isFile()){
+        return false;
+    }
+
+    // millisecond modification time and size only, so recently modified files are never cached (see isRecentlyModified)
+    identity.size = fileInfo.size();
+    identity.modificationTime = fileInfo.lastModified().toMSecsSinceEpoch() * 1000000;
+    return true;
+#endif
+}
+
+// A file modified in the last seconds can still be written in the same timestamp tick (coarse timestamps, FAT has 2s),
+// so a digest cached now could later be matched against different contents (the git "racy" index entries)
+bool isRecentlyModified(const FileIdentity &identity){
+    const qint64 racyInterval = qint64(3) * 1000000000;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch() * 1000000;
+
+    return qMax(identity.modificationTime, identity.changeTime) > now - racyInterval;
+}
+
+// Cache file format (little endian):
+// "CUHC" quint32(version)
+// then for each entry: quint8(algorithm) quint8(digest size) digest quint64(inode) qint64(size) qint64(modification time) qint64(change time) quint32(path size) path (utf-8)
+const char fileHashCacheMagic[] = "CUHC";
+const quint32 fileHashCacheVersion = 2;
+
+template<typename T>
+void appendLittleEndian(QByteArray &data, const T value){
+    const T littleEndianValue = qToLittleEndian(value);
+    data.append(reinterpret_cast<const char*>(&littleEndianValue), sizeof(T));
+}
+
+template<typename T>
+bool readLittleEndian(const char *&data, const char *end, T &value){
+    if(end - data < qptrdiff(sizeof(T))){
+        return false;
+    }
+    value = qFromLittleEndian<T>(reinterpret_cast<const uchar*>(data));
+    data += sizeof(T);
+    return true;
+}
+
+}
+
+struct FileHashCache::Private{
+    typedef QPair<QString, int> Key; // (absolute path, algorithm)
+
+    struct Entry{
+        FileIdentity identity;
+        QByteArray digest;
+    };
+
+    QString cacheFilePath;
+    QHash<Key, Entry> entries;
+    // dropped since the last save, so merging the file doesn't bring them back
+    QSet<Key> removedKeys;
+    bool isCleared = false;
+    QMutex mutex;
+
+    // Parses a cache file, returns false if it isn't valid
+    static bool parse(const QByteArray &data, QHash<Key, Entry> &parsedEntries){
+        const char *curr = data.constData();
+        const char *end = curr + data.size();
+        quint32 version;
+
+        if(data.size() < 4 || memcmp(curr, fileHashCacheMagic, 4) != 0){
+            return false;
+        }
+        curr += 4;
+
+        if(!readLittleEndian(curr, end, version)){
+            return false;
+        }
+
+        if(version != fileHashCacheVersion){
+            return true; // older format, its entries are simply hashed again
+        }
+
+        while(curr < end){
+            quint8 algorithm, digestSize;
+            quint32 pathSize;
+            Entry entry;
+
+            if(!readLittleEndian(curr, end, algorithm) || !readLittleEndian(curr, end, digestSize) || end - curr < digestSize){
+                return false;
+            }
+            entry.digest = QByteArray(curr, digestSize);
+            curr += digestSize;
+
+            if(!readLittleEndian(curr, end, entry.identity.inode) || !readLittleEndian(curr, end, entry.identity.size) ||
+                    !readLittleEndian(curr, end, entry.identity.modificationTime) || !readLittleEndian(curr, end, entry.identity.changeTime) ||
+                    !readLittleEndian(curr, end, pathSize) || quint32(end - curr) < pathSize){
+                return false;
+            }
+
+            parsedEntries.insert(Key(QString::fromUtf8(curr, int(pathSize)), algorithm), entry);
+            curr += pathSize;
+        }
+
+        return true;
+    }
+
+    static QByteArray serialize(const QHash<Key, Entry> &entriesToSerialize){
+        QByteArray data;
+        data.reserve(8 + entriesToSerialize.size() * 128);
+        data.append(fileHashCacheMagic, 4);
+        appendLittleEndian(data, fileHashCacheVersion);
+
+        for(auto it = entriesToSerialize.constBegin(); it != entriesToSerialize.constEnd(); ++it){
+            const QByteArray path = it.key().first.toUtf8();
+
+            appendLittleEndian(data, quint8(it.key().second));
+            appendLittleEndian(data, quint8(it.value().digest.size()));
+            data.append(it.value().digest);
+            appendLittleEndian(data, it.value().identity.inode);
+            appendLittleEndian(data, it.value().identity.size);
+            appendLittleEndian(data, it.value().identity.modificationTime);
+            appendLittleEndian(data, it.value().identity.changeTime);
+            appendLittleEndian(data, quint32(path.size()));
+            data.append(path);
+        }
+
+        return data;
+    }
+};
+
+FileHashCache::FileHashCache(const QString &cacheFilePath) : d(new Private){
+    d->cacheFilePath = cacheFilePath;
+}
+
+FileHashCache::~FileHashCache() = default;
+
+// Returns false if the cache file exists but couldn't be read (a missing file is just an empty cache)
+bool FileHashCache::load(){
+    QFile cacheFile(d->cacheFilePath);
+
+    if(!cacheFile.exists()){
+        return true;
+    }
+
+    // always replaced atomically on save, so no need to lock to read it
+    if(!cacheFile.open(QFile::ReadOnly)){
+        return false;
+    }
+
+    QHash<Private::Key, Private::Entry> loadedEntries;
+
+    if(!Private::parse(cacheFile.readAll(), loadedEntries)){
+        return false;
+    }
+
+    QMutexLocker locker(&d->mutex);
+
+    if(d->isCleared){
+        return true; // nothing on disk is wanted until the next save replaces it
+    }
+
+    // what we already have was checked more recently, and what we removed stays removed
+    for(auto it = loadedEntries.constBegin(); it != loadedEntries.constEnd(); ++it){
+        if(!d->entries.contains(it.key()) && !d->removedKeys.contains(it.key())){
+            d->entries.insert(it.key(), it.value());
+        }
+    }
+
+    return true;
+}
+
+// Merges with what other processes may have saved in the meantime and replaces the file atomically
+bool FileHashCache::save(){
+    QLockFile lockFile(d->cacheFilePath + ".lock");
+
+    if(!lockFile.lock()){
+        return false;
+    }
+
+    load(); // get the other writers' entries, an invalid file is simply overwritten
+
+    QByteArray data;
+    QSet<Private::Key> savedRemovedKeys;
+    bool wasCleared;
+
+    {
+        QMutexLocker locker(&d->mutex);
+        data = Private::serialize(d->entries);
+
+        // the file won't have them anymore
+        savedRemovedKeys.swap(d->removedKeys);
+        wasCleared = d->isCleared;
+        d->isCleared = false;
+    }
+
+    QSaveFile cacheFile(d->cacheFilePath);
+
+    if(!cacheFile.open(QFile::WriteOnly) || cacheFile.write(data) != data.size() || !cacheFile.commit()){
+        // still in the old file, so keep skipping them
+        QMutexLocker locker(&d->mutex);
+        d->removedKeys.unite(savedRemovedKeys);
+        d->isCleared = d->isCleared || wasCleared;
+        return false;
+    }
+
+    return true;
+}
+
+// Removes the entries of files that no longer exist or changed since they were hashed
+int FileHashCache::removeStaleEntries(){
+    QMutexLocker locker(&d->mutex);
+    int removed = 0;
+
+    for(auto it = d->entries.begin(); it != d->entries.end();){
+        FileIdentity currIdentity;
+
+        if(!getFileIdentity(it.key().first, currIdentity) || !(currIdentity == it.value().identity)){
+            d->removedKeys.insert(it.key());
+            it = d->entries.erase(it);
+            removed++;
+        }
+        else{
+            ++it;
+        }
+    }
+
+    return removed;
+}
+
+void FileHashCache::clear(){
+    QMutexLocker locker(&d->mutex);
+    d->entries.clear();
+    d->removedKeys.clear();
+    d->isCleared = true;
+}
+
+int FileHashCache::size() const{
+    QMutexLocker locker(&d->mutex);
+    return d->entries.size();
+}
+
+// Same as FileSystem::fileHash, but unchanged files are not read again. Thread safe.
+QString FileHashCache::fileHash(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm){
+    const Private::Key key(QFileInfo(fileName).absoluteFilePath(), int(hashAlgorithm));
+    FileIdentity identityBefore;
+
+    if(!getFileIdentity(key.first, identityBefore)){
+        return QString();
+    }
+
+    {
+        QMutexLocker locker(&d->mutex);
+        auto it = d->entries.constFind(key);
+
+        if(it != d->entries.constEnd() && it.value().identity == identityBefore){
+            return QString(it.value().digest.toHex());
+        }
+    }
+
+    QByteArray hash;
+    QString errorString;
+
+    if(!hashFileContents(fileName, hashAlgorithm, hash, errorString)){
+        return QString();
+    }
+
+    // only cache it if the file didn't change while it was being read and can't change unnoticed in the same timestamp tick
+    FileIdentity identityAfter;
+
+    if(getFileIdentity(key.first, identityAfter) && identityAfter == identityBefore && !isRecentlyModified(identityAfter)){
+        QMutexLocker locker(&d->mutex);
+        d->entries.insert(key, Private::Entry{identityBefore, hash});
+        d->removedKeys.remove(key);
+    }
+
+    return QString(hash.toHex());
+}
+
+
+namespace {
+
+const quint32 directoryHashTreeMagic = 0x43554454; // "CUDT"
+const quint32 directoryHashTreeVersion = 1;
+
+}
+
+DirectoryHashTree::DirectoryHashTree() : algorithm(QCryptographicHash::Sha1){
+}
+
+// The tree leaves (files) are hashed in parallel, then the folders are hashed bottom up
+// A folder hash covers the name, kind and hash of all its children, so any change inside changes it
+DirectoryHashTree DirectoryHashTree::build(const QString &rootPath, QCryptographicHash::Algorithm hashAlgorithm, int maxThreads, FileHashCache *cache){
+    DirectoryHashTree tree;
+    tree.algorithm = hashAlgorithm;
+
+    const QString absoluteRootPath = QDir(rootPath).absolutePath();
+
+    if(!QFileInfo(absoluteRootPath).isDir()){
+        return tree;
+    }
+
+    QStringList folders; // relative paths, parents always come before their children
+    QStringList filePaths;
+    QStringList fileRelativePaths;
+
+    folders << QString();
+    tree.nodes[QString()].isDir = true;
+
+    QDirIterator it(absoluteRootPath, QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+
+    while(it.hasNext()){
+        const QString currPath = it.next();
+        const QFileInfo currFileInfo = it.fileInfo();
+        const QString currRelativePath = currPath.mid(absoluteRootPath.size() + (absoluteRootPath.endsWith('/') ? 0 : 1));
+        const int lastSlash = currRelativePath.lastIndexOf('/');
+        const QString parentPath = lastSlash == -1 ? QString() : currRelativePath.left(lastSlash);
+
+        tree.nodes[parentPath].children << currRelativePath.mid(lastSlash + 1);
+
+        if(currFileInfo.isSymLink()){ // never followed, the link itself is the leaf
+            QCryptographicHash linkHash(hashAlgorithm);
+            linkHash.addData("l");
+            linkHash.addData(QFile::encodeName(currFileInfo.symLinkTarget()));
+            tree.nodes[currRelativePath].hash = linkHash.result();
+        }
+        else if(currFileInfo.isDir()){
+            folders << currRelativePath;
+            tree.nodes[currRelativePath].isDir = true;
+        }
+        else{
+            filePaths << currPath;
+            fileRelativePaths << currRelativePath;
+            tree.nodes[currRelativePath]; // hashed below
+        }
+    }
+
+    // parents before their children, so they can be hashed backwards
+    std::stable_sort(folders.begin(), folders.end(), [](const QString &first, const QString &second){
+        return (first.isEmpty() ? 0 : first.count('/') + 1) < (second.isEmpty() ? 0 : second.count('/') + 1);
+    });
+
+    // leaves
+    QVector<QByteArray> fileDigests(filePaths.size());
+    QVector<QString> fileErrors(filePaths.size());
+    QByteArray *fileDigestsData = fileDigests.data();
+    QString *fileErrorsData = fileErrors.data();
+
+    parallelFor(filePaths.size(), maxThreads, [&](const int i){
+        if(cache != nullptr){
+            const QString hexHash = cache->fileHash(filePaths.at(i), hashAlgorithm);
+            if(hexHash.isEmpty()){
+                fileErrorsData[i] = "Couldn't read the file.";
+            }
+            fileDigestsData[i] = QByteArray::fromHex(hexHash.toLatin1());
+        }
+        else if(!hashFileContents(filePaths.at(i), hashAlgorithm, fileDigestsData[i], fileErrorsData[i]) && fileErrorsData[i].isEmpty()){
+            fileErrorsData[i] = "Couldn't read the file.";
+        }
+    });
+
+    for(int i = 0; i < filePaths.size(); i++){
+        QCryptographicHash leafHash(hashAlgorithm);
+        leafHash.addData("f");
+        leafHash.addData(fileDigests.at(i));
+        tree.nodes[fileRelativePaths.at(i)].hash = leafHash.result();
+
+        if(!fileErrors.at(i).isEmpty()){
+            tree.errorList << FileHashResult{filePaths.at(i), QString(), fileErrors.at(i)};
+        }
+    }
+
+    // folders, children first
+    for(int i = folders.size() - 1; i >= 0; i--){
+        Node &currFolder = tree.nodes[folders.at(i)];
+        QCryptographicHash folderHash(hashAlgorithm);
+
+        currFolder.children.sort();
+        folderHash.addData("d");
+
+        for(const QString &currChild : currFolder.children){
+            const Node &currChildNode = tree.nodes.value(folders.at(i).isEmpty() ? currChild : folders.at(i) + "/" + currChild);
+            folderHash.addData(currChildNode.isDir ? "d" : "f");
+            folderHash.addData(currChild.toUtf8());
+            folderHash.addData("/", 1);
+            folderHash.addData(currChildNode.hash);
+        }
+
+        currFolder.hash = folderHash.result();
+    }
+
+    return tree;
+}
+
+bool DirectoryHashTree::isEmpty() const{
+    return nodes.isEmpty();
+}
+
+QByteArray DirectoryHashTree::rootHash() const{
+    return hash(QString());
+}
+
+// Hash of a file or folder (relative to the root, "" is the root itself), empty if it isn't in the tree
+QByteArray DirectoryHashTree::hash(const QString &relativePath) const{
+    return nodes.value(relativePath).hash;
+}
+
+// Paths (relative to the root) added, removed or modified since the previous tree
+// Only the topmost changed path is reported, e.g. a new folder is reported but not its contents
+QStringList DirectoryHashTree::changedPaths(const DirectoryHashTree &previous) const{
+    QStringList changed;
+
+    if(algorithm != previous.algorithm || isEmpty() != previous.isEmpty()){
+        changed << QString();
+        return changed;
+    }
+
+    std::function<void(const QString&)> compareNode = [&](const QString &relativePath){
+        const Node currNode = nodes.value(relativePath);
+        const Node previousNode = previous.nodes.value(relativePath);
+
+        if(currNode.hash == previousNode.hash && currNode.isDir == previousNode.isDir){
+            return; // the whole subtree is the same
+        }
+
+        if(!currNode.isDir || !previousNode.isDir){
+            changed << relativePath;
+            return;
+        }
+
+        QStringList allChildren = currNode.children + previousNode.children;
+        allChildren.removeDuplicates();
+        allChildren.sort();
+
+        for(const QString &currChild : allChildren){
+            const QString childPath = relativePath.isEmpty() ? currChild : relativePath + "/" + currChild;
+
+            if(!nodes.contains(childPath) || !previous.nodes.contains(childPath)){
+                changed << childPath;
+            }
+            else{
+                compareNode(childPath);
+            }
+        }
+    };
+
+    if(!isEmpty()){
+        compareNode(QString());
+    }
+
+    return changed;
+}
+
+// Files that couldn't be hashed during build
+QList<FileHashResult> DirectoryHashTree::errors() const{
+    return errorList;
+}
+
+// To keep the tree as the previous snapshot for a later run
+QByteArray DirectoryHashTree::toByteArray() const{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream << directoryHashTreeMagic << directoryHashTreeVersion << qint32(algorithm) << qint32(nodes.size());
+
+    for(auto it = nodes.constBegin(); it != nodes.constEnd(); ++it){
+        stream << it.key() << it.value().hash << it.value().isDir << it.value().children;
+    }
+
+    return data;
+}
+
+DirectoryHashTree DirectoryHashTree::fromByteArray(const QByteArray &data, bool *ok){
+    DirectoryHashTree tree;
+    QDataStream stream(data);
+    quint32 magic, version;
+    qint32 currAlgorithm, nodeCount;
+
+    stream >> magic >> version >> currAlgorithm >> nodeCount;
+
+    bool success = stream.status() == QDataStream::Ok && magic == directoryHashTreeMagic && version == directoryHashTreeVersion && nodeCount >= 0;
+
+    if(success){
+        tree.algorithm = QCryptographicHash::Algorithm(currAlgorithm);
+
+        for(qint32 i = 0; i < nodeCount && stream.status() == QDataStream::Ok; i++){
+            QString currPath;
+            Node currNode;
+            stream >> currPath >> currNode.hash >> currNode.isDir >> currNode.children;
+            tree.nodes.insert(currPath, currNode);
+        }
+
+        success = stream.status() == QDataStream::Ok;
+    }
+
+    if(!success){
+        tree = DirectoryHashTree();
+    }
+
+    if(ok != nullptr){
+        *ok = success;
+    }
+
+    return tree;
+}
+
+namespace {
+
+QThreadPool &asyncThreadPool(){
+    static QThreadPool pool;
+    return pool;
+}
+
+// Runs job in the async pool, job reports its results / progress in the future interface and checks isCanceled
+template<typename T>
+QFuture<T> runAsync(const std::function<void(QFutureInterface<T> &futureInterface)> &job){
+    QFutureInterface<T> futureInterface;
+    futureInterface.reportStarted();
+
+    const QFuture<T> future = futureInterface.future();
+
+    asyncThreadPool().start(new FunctionRunnable([futureInterface, job]() mutable{
+        if(!futureInterface.isCanceled()){
+            job(futureInterface);
+        }
+        futureInterface.reportFinished();
+    }));
+
+    return future;
+}
+
+// QFutureInterface progress is an int, so past INT_MAX both values are scaled down by the same factor
+void setProgress(QFutureInterfaceBase &futureInterface, const qint64 done, const qint64 total){
+    const qint64 scale = total / INT_MAX + 1;
+
+    futureInterface.setProgressRange(0, int(total / scale));
+    futureInterface.setProgressValue(int(qMin(done, total) / scale));
+}
+
+}
+
+// Maximum number of async calls running at the same time (each one can still use its own worker threads)
+void setAsyncMaxThreadCount(int maxThreads){
+    asyncThreadPool().setMaxThreadCount(resolveThreadCount(maxThreads));
+}
+
+int asyncMaxThreadCount(){
+    return asyncThreadPool().maxThreadCount();
+}
+
+// Progress is in files (the total grows while the tree is walked), cancel() stops it cooperatively
+QFuture<CopyDirResult> copyDirAsync(const QString &fromPath, const QString &toPath, const CopyDirOptions &options){
+    return runAsync<CopyDirResult>([fromPath, toPath, options](QFutureInterface<CopyDirResult> &futureInterface){
+        CopyDirOptions asyncOptions = options;
+
+        asyncOptions.isCanceled = [&futureInterface, options](){
+            return futureInterface.isCanceled() || (options.isCanceled && options.isCanceled());
+        };
+        asyncOptions.progress = [&futureInterface, options](const qint64 done, const qint64 total){
+            setProgress(futureInterface, done, total);
+            if(options.progress){
+                options.progress(done, total);
+            }
+        };
+
+        futureInterface.reportResult(copyDir(fromPath, toPath, asyncOptions));
+    });
+}
+
+// Progress is in entries removed (the total grows while the tree is walked), cancel() stops it cooperatively
+QFuture<RmDirResult> rmDirAsync(const QString &dirPath, const RmDirOptions &options){
+    return runAsync<RmDirResult>([dirPath, options](QFutureInterface<RmDirResult> &futureInterface){
+        RmDirOptions asyncOptions = options;
+
+        asyncOptions.isCanceled = [&futureInterface, options](){
+            return futureInterface.isCanceled() || (options.isCanceled && options.isCanceled());
+        };
+        asyncOptions.progress = [&futureInterface, options](const qint64 done, const qint64 total){
+            setProgress(futureInterface, done, total);
+            if(options.progress){
+                options.progress(done, total);
+            }
+        };
+
+        futureInterface.reportResult(rmDir(dirPath, asyncOptions));
+    });
+}
+
+// Each matching file is a result of the future as soon as it is found (e.g. QFutureWatcher::resultReadyAt)
+QFuture<QString> getFolderFilesByWildcardAsync(const QString &entryFolder, const QString &wildcard, bool isRecursive){
+    return runAsync<QString>([entryFolder, wildcard, isRecursive](QFutureInterface<QString> &futureInterface){
+        forEachFileByWildcard(entryFolder, wildcard, isRecursive, [&futureInterface](const QString &filePath){
+            futureInterface.reportResult(filePath, futureInterface.resultCount());
+            return !futureInterface.isCanceled();
+        });
+    });
+}
+
+// Empty QString on failure (like fileHash)
+QFuture<QString> fileHashAsync(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm){
+    return runAsync<QString>([fileName, hashAlgorithm](QFutureInterface<QString> &futureInterface){
+        QByteArray hash;
+        QString errorString;
+
+        if(hashFileContents(fileName, hashAlgorithm, hash, errorString, [&futureInterface](){ return futureInterface.isCanceled(); })){
+            futureInterface.reportResult(QString(hash.toHex()));
+        }
+        else{
+            futureInterface.reportResult(QString());
+        }
+    });
+}
+
+// A result for each file as soon as it is hashed (not in the fileNames order), progress is in files
+QFuture<FileHashResult> fileHashesAsync(const QStringList &fileNames, QCryptographicHash::Algorithm hashAlgorithm, int maxThreads){
+    return runAsync<FileHashResult>([fileNames, hashAlgorithm, maxThreads](QFutureInterface<FileHashResult> &futureInterface){
+        QMutex resultMutex;
+        int filesDone = 0;
+
+        futureInterface.setProgressRange(0, fileNames.size());
+
+        const std::function<bool()> isCanceled = [&futureInterface](){
+            return futureInterface.isCanceled();
+        };
+
+        parallelFor(fileNames.size(), maxThreads, [&](const int i){
+            if(isCanceled()){
+                return;
+            }
+
+            FileHashResult currResult;
+            QByteArray hash;
+
+            currResult.fileName = fileNames.at(i);
+
+            if(hashFileContents(currResult.fileName, hashAlgorithm, hash, currResult.errorString, isCanceled)){
+                currResult.hash = QString(hash.toHex());
+            }
+            else if(currResult.errorString.isEmpty()){
+                currResult.errorString = "Couldn't read the file.";
+            }
+
+            QMutexLocker locker(&resultMutex);
+            futureInterface.reportResult(currResult, filesDone);
+            futureInterface.setProgressValue(++filesDone);
+        });
+    });
+}
+
+/**
+  Gets application directory. In mac os gets the .app directory
+  **/
+QString getAppPath(){
+#ifdef Q_OS_MAC
+    QDir dir = QDir(QCoreApplication::applicationDirPath());
+    if(dir.absolutePath().contains(".app")){ // include bundle, but we don't want it
+        dir.cdUp();
+        dir.cdUp();
+        dir.cdUp();
+    }
+    return dir.absolutePath();
+#else
+    return  QDir::currentPath();
+#endif
+}
+
+bool backupFile(const QString &file, QString newFilename){
+	
+	if(newFilename.isEmpty()){
+		newFilename = file;
+	}
+	
+    return QFile::copy(file, newFilename+".bak");
+}
+
+CopyStrategy backupFile(const QString &file, const QString &newFilename, const CloneMode cloneMode, QString *errorString){
+    return copyFile(file, (newFilename.isEmpty() ? file : newFilename) + ".bak", cloneMode, errorString);
+}
+
+}
+
+namespace String {
+
+QString insertApostrophes(const QString &currString){
+    return "'"+currString+"'";
+}
+
+QString insertQuotes(const QString &currString){
+    return "\""+currString+"\"";
+}
+
+namespace {
+
+// Removes the QChar::isSpace characters of source into destination (which can be source itself) and returns the new size.
+// The SIMD kernels copy whole blocks that have no whitespace candidates, the candidates being the Unicode whitespace
+// (9-13, 0x20, 0x85, 0xA0, 0x1680, 0x2000-0x200A, 0x2028, 0x2029, 0x202F, 0x205F, 0x3000) plus the other control chars,
+// and leave the blocks with candidates to QChar::isSpace
+typedef int (*RemoveWhitespaceFunction)(const ushort *source, int size, ushort *destination);
+
+inline int removeWhitespaceScalar(const ushort *source, const int from, const int to, ushort *destination, int destinationIdx){
+    for(int i = from; i < to; i++){
+        if(!QChar::isSpace(source[i])){
+            destination[destinationIdx++] = source[i];
+        }
+    }
+    return destinationIdx;
+}
+
+int removeWhitespaceGeneric(const ushort *source, const int size, ushort *destination){
+    return removeWhitespaceScalar(source, 0, size, destination, 0);
+}
+
+#ifdef UTIL_SSE2
+inline __m128i whitespaceCandidates(const __m128i chars){
+    const __m128i zero = _mm_setzero_si128();
+
+    // chars <= 0x20 (unsigned)
+    __m128i result = _mm_cmpeq_epi16(_mm_subs_epu16(chars, _mm_set1_epi16(0x20)), zero);
+    // 0x2000 - 0x200A and 0x2028 - 0x2029
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, _mm_set1_epi16(0x2000)), _mm_set1_epi16(0x0A)), zero));
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, _mm_set1_epi16(0x2028)), _mm_set1_epi16(0x01)), zero));
+    // singles
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(chars, _mm_set1_epi16(0x85)));
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(chars, _mm_set1_epi16(0xA0)));
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(chars, _mm_set1_epi16(0x1680)));
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(chars, _mm_set1_epi16(0x202F)));
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(chars, _mm_set1_epi16(0x205F)));
+    result = _mm_or_si128(result, _mm_cmpeq_epi16(chars, _mm_set1_epi16(0x3000)));
+
+    return result;
+}
+
+int removeWhitespaceSse2(const ushort *source, const int size, ushort *destination){
+    int i = 0;
+    int destinationIdx = 0;
+
+    for(; i + 8 <= size; i += 8){
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+
+        if(_mm_movemask_epi8(whitespaceCandidates(chars)) == 0){
+            if(destination != source || destinationIdx != i){
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + destinationIdx), chars);
+            }
+            destinationIdx += 8;
+        }
+        else{
+            destinationIdx = removeWhitespaceScalar(source, i, i + 8, destination, destinationIdx);
+        }
+    }
+
+    return removeWhitespaceScalar(source, i, size, destination, destinationIdx);
+}
+#endif
+
+#ifdef UTIL_AVX2
+__attribute__((target("avx2")))
+inline __m256i whitespaceCandidatesAvx2(const __m256i chars){
+    const __m256i zero = _mm256_setzero_si256();
+
+    __m256i result = _mm256_cmpeq_epi16(_mm256_subs_epu16(chars, _mm256_set1_epi16(0x20)), zero);
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(_mm256_subs_epu16(_mm256_sub_epi16(chars, _mm256_set1_epi16(0x2000)), _mm256_set1_epi16(0x0A)), zero));
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(_mm256_subs_epu16(_mm256_sub_epi16(chars, _mm256_set1_epi16(0x2028)), _mm256_set1_epi16(0x01)), zero));
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(0x85)));
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(0xA0)));
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(0x1680)));
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(0x202F)));
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(0x205F)));
+    result = _mm256_or_si256(result, _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(0x3000)));
+
+    return result;
+}
+
+__attribute__((target("avx2")))
+int removeWhitespaceAvx2(const ushort *source, const int size, ushort *destination){
+    int i = 0;
+    int destinationIdx = 0;
+
+    for(; i + 16 <= size; i += 16){
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+
+        if(_mm256_movemask_epi8(whitespaceCandidatesAvx2(chars)) == 0){
+            if(destination != source || destinationIdx != i){
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + destinationIdx), chars);
+            }
+            destinationIdx += 16;
+        }
+        else{
+            destinationIdx = removeWhitespaceScalar(source, i, i + 16, destination, destinationIdx);
+        }
+    }
+
+    return removeWhitespaceScalar(source, i, size, destination, destinationIdx);
+}
+#endif
+
+// Index of the first whitespace or size if there's none
+int indexOfWhitespace(const ushort *source, const int size){
+    int i = 0;
+
+#ifdef UTIL_SSE2
+    while(i + 8 <= size && _mm_movemask_epi8(whitespaceCandidates(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)))) == 0){
+        i += 8;
+    }
+#endif
+
+    while(i < size && !QChar::isSpace(source[i])){
+        i++;
+    }
+
+    return i;
+}
+
+RemoveWhitespaceFunction removeWhitespaceKernel(){
+    static const RemoveWhitespaceFunction kernel = []() -> RemoveWhitespaceFunction{
+#ifdef UTIL_AVX2
+        if(__builtin_cpu_supports("avx2")){
+            return &removeWhitespaceAvx2;
+        }
+#endif
+#ifdef UTIL_SSE2
+        return &removeWhitespaceSse2;
+#else
+        return &removeWhitespaceGeneric;
+#endif
+    }();
+
+    return kernel;
+}
+
+}
+
+// Removes all the whitespace (same result as simplified() followed by removing the spaces)
+QString fullTrim(QString str) {
+    fullTrimInPlace(str);
+    return str;
+}
+
+QString fullTrim(QStringView str){
+    QString result(int(str.size()), Qt::Uninitialized);
+
+    result.resize(removeWhitespaceKernel()(reinterpret_cast<const ushort*>(str.data()), int(str.size()), reinterpret_cast<ushort*>(result.data())));
+
+    return result;
+}
+
+void fullTrimInPlace(QString &str){
+    const ushort *source = str.utf16();
+    const int size = str.size();
+
+    // find the first whitespace before detaching, strings without any are left untouched
+    const int firstSpace = indexOfWhitespace(source, size);
+
+    if(firstSpace == size){
+        return;
+    }
+
+    ushort *data = reinterpret_cast<ushort*>(str.data()) + firstSpace;
+
+    str.resize(firstSpace + removeWhitespaceKernel()(data, size - firstSpace, data));
+}
+
+namespace {
+
+inline ushort foldChar(const ushort character, const Qt::CaseSensitivity cs){
+    return cs == Qt::CaseSensitive ? character : QChar::toCaseFolded(character);
+}
+
+inline bool equalsFolded(const ushort *text, const ushort *toSearch, const int toSearchSize, const Qt::CaseSensitivity cs){
+    if(cs == Qt::CaseSensitive){
+        return memcmp(text, toSearch, toSearchSize * sizeof(ushort)) == 0;
+    }
+
+    for(int i = 0; i < toSearchSize; i++){
+        if(text[i] != toSearch[i] && QChar::toCaseFolded(text[i]) != QChar::toCaseFolded(toSearch[i])){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Needles up to this size are searched with a SIMD scan for their first (last when backward) char, longer ones with Boyer-Moore-Horspool
+const int shortNeedleSize = 4;
+
+// First start in [from, size - toSearchSize] or -1, toSearch not empty
+int findForward(const ushort *text, const int size, const ushort *toSearch, const int toSearchSize, const int from, const Qt::CaseSensitivity cs){
+    const int lastStart = size - toSearchSize;
+
+    if(from > lastStart){
+        return -1;
+    }
+
+    if(cs == Qt::CaseSensitive && toSearchSize <= shortNeedleSize){
+        for(int i = indexOfChar(text, lastStart + 1, toSearch[0], from); i != -1; i = indexOfChar(text, lastStart + 1, toSearch[0], i + 1)){
+            if(equalsFolded(text + i, toSearch, toSearchSize, cs)){
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // the skip table is indexed by the low byte of the (folded) char, so chars sharing it keep the smallest skip
+    int skips[256];
+    std::fill(skips, skips + 256, toSearchSize);
+
+    for(int i = 0; i < toSearchSize - 1; i++){
+        skips[foldChar(toSearch[i], cs) & 0xFF] = toSearchSize - 1 - i;
+    }
+
+    const ushort lastChar = foldChar(toSearch[toSearchSize - 1], cs);
+
+    for(int i = from; i <= lastStart;){
+        const ushort currChar = foldChar(text[i + toSearchSize - 1], cs);
+
+        if(currChar == lastChar && equalsFolded(text + i, toSearch, toSearchSize - 1, cs)){
+            return i;
+        }
+
+        i += skips[currChar & 0xFF];
+    }
+
+    return -1;
+}
+
+// Last start in [0, from] or -1, toSearch not empty and from <= size - toSearchSize
+int findBackward(const ushort *text, const int size, const ushort *toSearch, const int toSearchSize, const int from, const Qt::CaseSensitivity cs){
+    Q_UNUSED(size);
+
+    if(from < 0){
+        return -1;
+    }
+
+    if(cs == Qt::CaseSensitive && toSearchSize <= shortNeedleSize){
+        for(int i = lastIndexOfChar(text, from + 1, toSearch[0]); i != -1; i = lastIndexOfChar(text, i, toSearch[0])){
+            if(equalsFolded(text + i, toSearch, toSearchSize, cs)){
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // mirrored Horspool, the window is aligned on its first char
+    int skips[256];
+    std::fill(skips, skips + 256, toSearchSize);
+
+    for(int i = toSearchSize - 1; i > 0; i--){
+        skips[foldChar(toSearch[i], cs) & 0xFF] = i;
+    }
+
+    const ushort firstChar = foldChar(toSearch[0], cs);
+
+    for(int i = from; i >= 0;){
+        const ushort currChar = foldChar(text[i], cs);
+
+        if(currChar == firstChar && equalsFolded(text + i + 1, toSearch + 1, toSearchSize - 1, cs)){
+            return i;
+        }
+
+        i -= skips[currChar & 0xFF];
+    }
+
+    return -1;
+}
+
+}
+
+int indexOf(QStringView text, QStringView toSearch, int from, Qt::CaseSensitivity cs){
+    const int size = int(text.size());
+
+    if(from < 0){
+        from = qMax(0, from + size);
+    }
+
+    if(toSearch.isEmpty()){
+        return from <= size ? from : -1;
+    }
+
+    return findForward(reinterpret_cast<const ushort*>(text.data()), size, reinterpret_cast<const ushort*>(toSearch.data()), int(toSearch.size()), from, cs);
+}
+
+int lastIndexOf(QStringView text, QStringView toSearch, int from, Qt::CaseSensitivity cs){
+    const int size = int(text.size());
+    const int toSearchSize = int(toSearch.size());
+
+    if(from < 0){
+        from += size;
+        if(from < 0){
+            return -1;
+        }
+    }
+
+    if(toSearch.isEmpty()){
+        return qMin(from, size);
+    }
+
+    return findBackward(reinterpret_cast<const ushort*>(text.data()), size, reinterpret_cast<const ushort*>(toSearch.data()), toSearchSize, qMin(from, size - toSearchSize), cs);
+}
+
+StringTokenizer::StringTokenizer(QStringView text, QStringView separator, Qt::CaseSensitivity cs)
+    : text(text), separator(separator), cs(cs), currIdx(0){
+}
+
+bool StringTokenizer::hasNext() const{
+    return currIdx != -1;
+}
+
+QStringView StringTokenizer::next(){
+    if(currIdx == -1){
+        return QStringView();
+    }
+
+    // an empty separator doesn't split anything
+    const int nextIdx = separator.isEmpty() ? -1 : indexOf(text, separator, currIdx, cs);
+
+    QStringView token;
+
+    if(nextIdx == -1){
+        token = text.mid(currIdx);
+        currIdx = -1;
+    }
+    else{
+        token = text.mid(currIdx, nextIdx - currIdx);
+        currIdx = nextIdx + int(separator.size());
+    }
+
+    return token;
+}
+
+QVector<QStringView> splitView(QStringView text, QStringView separator, Qt::CaseSensitivity cs){
+    QVector<QStringView> result;
+
+    // count first so the result is allocated only once
+    int tokenCount = 1;
+
+    if(!separator.isEmpty()){
+        for(int currIdx = indexOf(text, separator, 0, cs); currIdx != -1; currIdx = indexOf(text, separator, currIdx + int(separator.size()), cs)){
+            tokenCount++;
+        }
+    }
+
+    result.reserve(tokenCount);
+
+    StringTokenizer tokenizer(text, separator, cs);
+
+    while(tokenizer.hasNext()){
+        result << tokenizer.next();
+    }
+
+    return result;
+}
+
+QStringList substring(const QString &myString, const QString &separator, Qt::CaseSensitivity cs){
+    const QVector<QStringView> tokens = splitView(myString, separator, cs);
+
+    QStringList result;
+    result.reserve(tokens.size());
+
+    for(const QStringView &currToken : tokens){
+        result << currToken.toString();
+    }
+
+    return result;
+}
+
+QString normalizeDecimalSeparator(QString value){
+    normalizeDecimalSeparatorInPlace(value);
+    return value;
+}
+
+void normalizeDecimalSeparatorInPlace(QString &value){
+    replaceChar(value, ',', '.');
+}
+
+void normalizeDecimalSeparators(QStringList &values){
+    for(QString &currValue : values){
+        replaceChar(currValue, ',', '.');
+    }
+}
+
+//Searches for the QString "toSearch" in the "myString" variable backward, the match must end at or before "from" (-1 = the end)
+//Returns the index of the first match or -1 if not found
+int indexOfBackward(const QString &myString, const QString &toSearch, int from){
+    if(from < 0 || from > myString.size()){
+        from = myString.size();
+    }
+
+    const int lastStart = from - toSearch.size();
+
+    return lastStart < 0 ? -1 : lastIndexOf(myString, toSearch, lastStart);
+}
+
+MultiStringSearcher::MultiStringSearcher(const QStringList &keywords, const Qt::CaseSensitivity cs) : cs(cs){
+    std::fill(asciiClasses, asciiClasses + 128, 0);
+
+    // class 0 is every char that isn't in any keyword
+    int classCount = 1;
+
+    auto charClass = [this, &classCount](const ushort character){
+        if(character < 128){
+            if(asciiClasses[character] == 0){
+                asciiClasses[character] = classCount++;
+            }
+            return asciiClasses[character];
+        }
+
+        int &currClass = otherClasses[character];
+        if(currClass == 0){
+            currClass = classCount++;
+        }
+        return currClass;
+    };
+
+    // trie, -1 when there's no child yet
+    std::vector<std::vector<int>> children;
+    std::vector<int> stateKeywords; // keyword ending in each state (-1 if none)
+    children.push_back(std::vector<int>());
+    stateKeywords.push_back(-1);
+
+    QVector<QVector<int>> keywordClasses;
+    keywordClasses.reserve(keywords.size());
+
+    for(const QString &currKeyword : keywords){
+        QVector<int> currClasses;
+        currClasses.reserve(currKeyword.size());
+
+        for(const QChar currChar : currKeyword){
+            currClasses << charClass(foldChar(currChar.unicode(), cs));
+        }
+
+        keywordClasses << currClasses;
+        keywordLengths.push_back(currKeyword.size());
+    }
+
+    for(int i = 0; i < keywordClasses.size(); i++){
+        int state = 0;
+
+        for(const int currClass : keywordClasses.at(i)){
+            if(int(children[state].size()) <= currClass){
+                children[state].resize(classCount, -1);
+            }
+
+            if(children[state][currClass] == -1){
+                children[state][currClass] = int(children.size());
+                children.push_back(std::vector<int>());
+                stateKeywords.push_back(-1);
+            }
+
+            state = children[state][currClass];
+        }
+
+        // empty keywords are never reported, duplicated ones are reported with their first index
+        if(state != 0 && stateKeywords[state] == -1){
+            stateKeywords[state] = i;
+        }
+    }
+
+    const int stateCount = int(children.size());
+
+    classesPerState = classCount;
+    transitions.assign(size_t(stateCount) * classCount, 0);
+    outputs = stateKeywords;
+    outputLinks.assign(stateCount, -1);
+
+    std::vector<int> failLinks(stateCount, 0);
+    std::vector<int> pending;
+    pending.reserve(stateCount);
+
+    // breadth first, so the fail state of each state is already complete
+    for(int currClass = 0; currClass < int(children[0].size()); currClass++){
+        const int child = children[0][currClass];
+        if(child != -1){
+            transitions[currClass] = child;
+            pending.push_back(child);
+        }
+    }
+
+    for(size_t i = 0; i < pending.size(); i++){
+        const int state = pending[i];
+        const int failState = failLinks[state];
+
+        // nearest state down the fail chain that ends a keyword
+        outputLinks[state] = outputs[failState] != -1 ? failState : outputLinks[failState];
+
+        for(int currClass = 0; currClass < classCount; currClass++){
+            const int child = currClass < int(children[state].size()) ? children[state][currClass] : -1;
+
+            if(child != -1){
+                failLinks[child] = transitions[size_t(failState) * classCount + currClass];
+                transitions[size_t(state) * classCount + currClass] = child;
+                pending.push_back(child);
+            }
+            else{
+                transitions[size_t(state) * classCount + currClass] = transitions[size_t(failState) * classCount + currClass];
+            }
+        }
+    }
+}
+
+bool MultiStringSearcher::forEachMatch(QStringView text, const std::function<bool(int position, int keywordIndex)> &callback) const{
+    const ushort *data = reinterpret_cast<const ushort*>(text.data());
+    const int size = int(text.size());
+    int state = 0;
+
+    for(int i = 0; i < size; i++){
+        const ushort currChar = foldChar(data[i], cs);
+        const int currClass = currChar < 128 ? asciiClasses[currChar] : otherClasses.value(currChar, 0);
+
+        state = transitions[size_t(state) * classesPerState + currClass];
+
+        for(int currState = outputs[state] != -1 ? state : outputLinks[state]; currState != -1; currState = outputLinks[currState]){
+            const int keywordIndex = outputs[currState];
+            if(!callback(i + 1 - keywordLengths[keywordIndex], keywordIndex)){
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+QVector<MultiStringSearcher::Match> MultiStringSearcher::findAll(QStringView text) const{
+    QVector<Match> result;
+
+    forEachMatch(text, [&result](const int position, const int keywordIndex){
+        result << Match{position, keywordIndex};
+        return true;
+    });
+
+    return result;
+}
+
+bool MultiStringSearcher::containsAny(QStringView text) const{
+    return !forEachMatch(text, [](int, int){
+        return false;
+    });
+}
+
+int MultiStringSearcher::keywordCount() const{
+    return int(keywordLengths.size());
+}
+
+// no problem here with "temporary" cstr
+// https://stackoverflow.com/questions/1971183/when-does-c-allocate-deallocate-string-literals
+const char* boolToCstr(bool currentBoolean){
+    return currentBoolean ? "true" : "false";
+}
+
+}
+
+#ifdef QT_GUI_LIB
+namespace Dialogs {
+
+void showInfo(const QString &message, const bool richText){
+    QMessageBox msgBox;
+	if(richText){
+		msgBox.setTextFormat(Qt::RichText);
+	}
+    msgBox.setIcon(QMessageBox::Information);
+    msgBox.setText(message);
+    msgBox.exec();
+}
+
+void showWarning(const QString &message, const bool richText){
+    QMessageBox msgBox;
+	if(richText){
+		msgBox.setTextFormat(Qt::RichText);
+	}
+    msgBox.setIcon(QMessageBox::Warning);
+    msgBox.setText(message);
+    msgBox.exec();
+}
+
+void showError(const QString &message, const bool richText){
+    QMessageBox msgBox;
+	if(richText){
+		msgBox.setTextFormat(Qt::RichText);
+	}
+    msgBox.setIcon(QMessageBox::Critical);
+    msgBox.setText(message);
+    msgBox.exec();
+}
+
+bool showQuestion(QWidget * parent, QString message, QMessageBox::StandardButton standardButton){
+    return QMessageBox::question (parent, "Are you sure?", message, QMessageBox::Yes | QMessageBox::No, standardButton)==QMessageBox::Yes;
+}
+
+QMessageBox::StandardButton showQuestionWithCancel(QWidget * parent, QString message, QMessageBox::StandardButton standardButton){
+    return QMessageBox::question (parent, "Are you sure?", message, QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, standardButton);
+}
+
+QStringList multipleDirSelection(const QString &title){
+    QFileDialog w;
+
+    // We need to use non native dialog, because native doesn't support multiple folder selection
+    w.setOption(QFileDialog::DontUseNativeDialog,true);
+
+    w.setFileMode(QFileDialog::DirectoryOnly);
+
+    w.setWindowTitle(title);
+
+    QTreeView *t = w.findChild<QTreeView*>();
+
+    if (t) {
+        t->setSelectionMode(QAbstractItemView::MultiSelection);
+    }
+
+    if(w.exec()){ //if accepted
+        return w.selectedFiles();
+    }
+    return QStringList(); //return empty
+}
+
+}
+#endif
+
+namespace Validation {
+
+// Check if any string in the list is empty
+bool checkEmptySpaces(const QStringList &toCheck){
+    for (const QString &current : toCheck){
+        if(current.trimmed().isEmpty()){
+            return true; //There are empty spaces
+        }
+    }
+    return false;
+}
+
+bool checkIfIntegers(const QStringList &toCheck){
+    return firstNonInteger(toCheck) != -1; // Some aren't valid integers
+}
+
+bool checkIfDoubles(const QStringList &toCheck){
+    return firstNonDouble(toCheck) != -1; // Some aren't valid doubles
+}
+
+namespace {
+
+// Number of ASCII digits at the start of data
+int countDigits(const ushort *data, const int size){
+    int i = 0;
+
+#ifdef UTIL_SSE2
+    const __m128i zeroChar = _mm_set1_epi16('0');
+    const __m128i nine = _mm_set1_epi16(9);
+
+    for(; i + 8 <= size; i += 8){
+        const __m128i digits = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), zeroChar);
+        const int notDigits = ~_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(digits, nine), _mm_setzero_si128())) & 0xFFFF;
+        if(notDigits != 0){
+            return i + qCountTrailingZeroBits(quint32(notDigits)) / 2;
+        }
+    }
+#endif
+
+    while(i < size && data[i] >= '0' && data[i] <= '9'){
+        i++;
+    }
+
+    return i;
+}
+
+// The fast paths only accept plain numbers that are surely valid, anything else (whitespace, '+', 10 or more digits,
+// inf / nan, huge exponents...) is decided by toInt / toDouble, so the result is always the same as theirs
+bool isIntegerFast(const QString &value){
+    const ushort *data = value.utf16();
+    const int size = value.size();
+    const int start = size > 0 && data[0] == '-' ? 1 : 0;
+    const int digits = countDigits(data + start, size - start);
+
+    if(digits > 0 && digits < 10 && start + digits == size){
+        return true;
+    }
+
+    bool isNumber;
+    value.toInt(&isNumber);
+    return isNumber;
+}
+
+bool isDoubleFast(const QString &value){
+    const ushort *data = value.utf16();
+    const int size = value.size();
+
+    if(size <= 64){
+        int i = size > 0 && data[0] == '-' ? 1 : 0;
+        int digits = countDigits(data + i, size - i);
+        bool isPlain = digits > 0;
+        i += digits;
+
+        if(isPlain && i < size && data[i] == '.'){
+            i++;
+            digits = countDigits(data + i, size - i);
+            isPlain = digits > 0;
+            i += digits;
+        }
+
+        if(isPlain && i < size && (data[i] == 'e' || data[i] == 'E')){
+            i++;
+            if(i < size && (data[i] == '-' || data[i] == '+')){
+                i++;
+            }
+            digits = countDigits(data + i, size - i);
+            isPlain = digits > 0 && digits <= 2; // can't overflow with up to 64 chars
+            i += digits;
+        }
+
+        if(isPlain && i == size){
+            return true;
+        }
+    }
+
+    bool isDouble;
+    value.toDouble(&isDouble);
+    return isDouble;
+}
+
+// Index of the first element failing isValid, lists this big are split between threads
+const int parallelValidationSize = 100000;
+
+int firstInvalid(const QStringList &toCheck, const int maxThreads, bool (*isValid)(const QString &value)){
+    if(toCheck.size() < parallelValidationSize){
+        for(int i = 0; i < toCheck.size(); i++){
+            if(!isValid(toCheck.at(i))){
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    const int chunkSize = parallelValidationSize / 4;
+    const int chunkCount = (toCheck.size() + chunkSize - 1) / chunkSize;
+    std::atomic<int> firstInvalidIndex(INT_MAX);
+
+    parallelFor(chunkCount, maxThreads, [&](const int chunk){
+        const int end = qMin(toCheck.size(), (chunk + 1) * chunkSize);
+
+        for(int i = chunk * chunkSize; i < end && i < firstInvalidIndex; i++){
+            if(!isValid(toCheck.at(i))){
+                int currFirst = firstInvalidIndex;
+                while(i < currFirst && !firstInvalidIndex.compare_exchange_weak(currFirst, i)){
+                }
+                return;
+            }
+        }
+    });
+
+    return firstInvalidIndex == INT_MAX ? -1 : int(firstInvalidIndex);
+}
+
+}
+
+namespace {
+
+// Exactly representable powers of ten, for the Clinger fast path
+const double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Parses [+-]digits[(.|,)digits][(e|E)[+-]digits] when the result is exact with a single multiplication or division
+// (mantissa up to 2^53 and power of ten up to 22), returns false for anything else
+bool parseDoubleFast(const ushort *data, const int size, double &value){
+    int i = 0;
+    bool isNegative = false;
+
+    if(i < size && (data[i] == '-' || data[i] == '+')){
+        isNegative = data[i] == '-';
+        i++;
+    }
+
+    quint64 mantissa = 0;
+    int mantissaDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+
+    for(; i < size && data[i] >= '0' && data[i] <= '9'; i++){
+        hasDigits = true;
+        if(mantissa == 0 && data[i] == '0'){
+            continue; // leading zeros don't count
+        }
+        if(++mantissaDigits > 19){
+            return false;
+        }
+        mantissa = mantissa * 10 + (data[i] - '0');
+    }
+
+    if(i < size && (data[i] == '.' || data[i] == ',')){
+        i++;
+        for(; i < size && data[i] >= '0' && data[i] <= '9'; i++){
+            hasDigits = true;
+            exponent--;
+            if(mantissa == 0 && data[i] == '0'){
+                continue;
+            }
+            if(++mantissaDigits > 19){
+                return false;
+            }
+            mantissa = mantissa * 10 + (data[i] - '0');
+        }
+    }
+
+    if(!hasDigits){
+        return false;
+    }
+
+    if(i < size && (data[i] == 'e' || data[i] == 'E')){
+        i++;
+        bool isExponentNegative = false;
+        if(i < size && (data[i] == '-' || data[i] == '+')){
+            isExponentNegative = data[i] == '-';
+            i++;
+        }
+
+        int explicitExponent = 0;
+        int exponentDigits = 0;
+        for(; i < size && data[i] >= '0' && data[i] <= '9'; i++){
+            if(++exponentDigits > 4){
+                return false;
+            }
+            explicitExponent = explicitExponent * 10 + (data[i] - '0');
+        }
+
+        if(exponentDigits == 0){
+            return false;
+        }
+
+        exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+    }
+
+    if(i != size || mantissa > (quint64(1) << 53)){
+        return false;
+    }
+
+    if(mantissa == 0){
+        value = isNegative ? -0.0 : 0.0;
+        return true;
+    }
+
+    if(exponent < -22 || exponent > 22){
+        return false;
+    }
+
+    value = double(mantissa);
+    value = exponent < 0 ? value / exactPowersOfTen[-exponent] : value * exactPowersOfTen[exponent];
+
+    if(isNegative){
+        value = -value;
+    }
+
+    return true;
+}
+
+// [+-]digits with up to 18 digits (can't overflow), returns false for anything else
+bool parseIntegerFast(const ushort *data, const int size, qint64 &value){
+    int i = 0;
+    bool isNegative = false;
+
+    if(i < size && (data[i] == '-' || data[i] == '+')){
+        isNegative = data[i] == '-';
+        i++;
+    }
+
+    const int digitsStart = i;
+    qint64 result = 0;
+
+    for(; i < size && data[i] >= '0' && data[i] <= '9'; i++){
+        result = result * 10 + (data[i] - '0');
+    }
+
+    if(i == digitsStart || i != size || i - digitsStart > 18){
+        return false;
+    }
+
+    value = isNegative ? -result : result;
+    return true;
+}
+
+}
+
+namespace {
+
+// The cells the fast paths don't take (whitespace, long mantissas, big exponents, inf / nan...) go through QLocale::c()
+double parseDoubleCell(QStringView cell, bool &isValid){
+    double value;
+
+    if(parseDoubleFast(reinterpret_cast<const ushort*>(cell.data()), int(cell.size()), value)){
+        isValid = true;
+        return value;
+    }
+
+    QVarLengthArray<QChar, 64> normalized(int(cell.size()));
+    for(int i = 0; i < normalized.size(); i++){
+        normalized[i] = cell[i] == QLatin1Char(',') ? QLatin1Char('.') : cell[i];
+    }
+
+    return QLocale::c().toDouble(QStringView(normalized.constData(), normalized.size()), &isValid);
+}
+
+qint64 parseIntegerCell(QStringView cell, bool &isValid){
+    qint64 value;
+
+    if(parseIntegerFast(reinterpret_cast<const ushort*>(cell.data()), int(cell.size()), value)){
+        isValid = true;
+        return value;
+    }
+
+    return QLocale::c().toLongLong(cell, &isValid);
+}
+
+template<typename Column, typename Cells, typename ParseCell>
+Column parseColumn(const Cells &cells, const ParseCell &parseCell, const typename Column::ValueType invalidValue){
+    Column result;
+    result.values.resize(size_t(cells.size()));
+    result.validity = QBitArray(cells.size());
+
+    for(int i = 0; i < cells.size(); i++){
+        bool isValid = false;
+        const typename Column::ValueType value = parseCell(QStringView(cells.at(i)), isValid);
+
+        if(isValid){
+            result.values[size_t(i)] = value;
+            result.validity.setBit(i);
+        }
+        else{
+            result.values[size_t(i)] = invalidValue;
+            result.invalidCount++;
+        }
+    }
+
+    return result;
+}
+
+}
+
+DoubleColumn parseDoubleColumn(const QStringList &cells){
+    return parseColumn<DoubleColumn>(cells, &parseDoubleCell, qQNaN());
+}
+
+DoubleColumn parseDoubleColumn(const QVector<QStringView> &cells){
+    return parseColumn<DoubleColumn>(cells, &parseDoubleCell, qQNaN());
+}
+
+IntegerColumn parseIntegerColumn(const QStringList &cells){
+    return parseColumn<IntegerColumn>(cells, &parseIntegerCell, qint64(0));
+}
+
+IntegerColumn parseIntegerColumn(const QVector<QStringView> &cells){
+    return parseColumn<IntegerColumn>(cells, &parseIntegerCell, qint64(0));
+}
+
+int firstNonInteger(const QStringList &toCheck, int maxThreads){
+    return firstInvalid(toCheck, maxThreads, &isIntegerFast);
+}
+
+int firstNonDouble(const QStringList &toCheck, int maxThreads){
+    return firstInvalid(toCheck, maxThreads, &isDoubleFast);
+}
+
+bool isStringInteger(const QString &myString){
+    return isIntegerFast(myString);
+}
+
+bool isStringDouble(const QString &myString){
+    return isDoubleFast(myString);
+}
+
+}
 
 namespace System {
 
+namespace {
+
+// Chars that never need quotes in a command line
+inline bool isShellSafeChar(const ushort character){
+    return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') || (character >= '0' && character <= '9') ||
+            character == '_' || character == '-' || character == '.' || character == '/' || character == ':' || character == '=' ||
+            character == '+' || character == ',' || character == '@'
+#ifndef Q_OS_WIN
+            || character == '%' // expands environment variables on Windows (%PATH%)
+#endif
+            ;
+}
+
+// Writes the argument between double quotes, with the QProcess::splitCommand rules (a quote is written as three quotes,
+// backslashes are just chars), and returns the size written
+// (with destination == nullptr it only counts, so the final buffer can be sized exactly)
+int writeQuoted(const ushort *source, const int size, ushort *destination){
+    int written = 0;
+
+    auto write = [destination, &written](const ushort character){
+        if(destination != nullptr){
+            destination[written] = character;
+        }
+        written++;
+    };
+
+    write('"');
+
+    for(int i = 0; i < size; i++){
+        if(source[i] == '"'){
+            write('"');
+            write('"');
+        }
+        write(source[i]);
+    }
+
+    write('"');
+
+    return written;
+}
+
+}
+
+CommandLineBuilder::CommandLineBuilder(const int reserveChars){
+    buffer.reserve(reserveChars);
+}
+
+CommandLineBuilder &CommandLineBuilder::addArgument(QStringView argument, const bool alwaysQuote){
+    appendArgument(argument, false, alwaysQuote);
+    return *this;
+}
+
+CommandLineBuilder &CommandLineBuilder::addPath(QStringView path){
+    // always quoted, like FileSystem::normalizeAndQuote
+    appendArgument(path, true, true);
+    return *this;
+}
+
+void CommandLineBuilder::appendArgument(QStringView argument, const bool isPath, bool quote){
+    const ushort *source = reinterpret_cast<const ushort*>(argument.data());
+    const int size = int(argument.size());
+    const int offset = buffer.size();
+
+    buffer.resize(offset + size);
+    ushort *destination = reinterpret_cast<ushort*>(buffer.data()) + offset;
+
+    // normalize while copying and check if it needs quotes in the same pass
+    quote = quote || size == 0;
+
+    for(int i = 0; i < size; i++){
+        const ushort currChar = isPath && source[i] == '\\' ? ushort('/') : source[i];
+        quote = quote || !isShellSafeChar(currChar);
+        destination[i] = currChar;
+    }
+
+    Argument currArgument;
+    currArgument.offset = offset;
+    currArgument.size = size;
+    currArgument.quoted = quote;
+
+    arguments << currArgument;
+
+    joinedSize += (arguments.size() > 1 ? 1 : 0) + (quote ? writeQuoted(destination, size, nullptr) : size);
+}
+
+int CommandLineBuilder::size() const{
+    return arguments.size();
+}
+
+void CommandLineBuilder::clear(){
+    buffer.clear();
+    arguments.clear();
+    joinedSize = 0;
+}
+
+QString CommandLineBuilder::toString() const{
+    QString result(joinedSize, Qt::Uninitialized);
+    ushort *destination = reinterpret_cast<ushort*>(result.data());
+    const ushort *source = buffer.utf16();
+
+    for(int i = 0; i < arguments.size(); i++){
+        const Argument &currArgument = arguments.at(i);
+
+        if(i > 0){
+            *destination++ = ' ';
+        }
+
+        if(currArgument.quoted){
+            destination += writeQuoted(source + currArgument.offset, currArgument.size, destination);
+        }
+        else{
+            memcpy(destination, source + currArgument.offset, currArgument.size * sizeof(ushort));
+            destination += currArgument.size;
+        }
+    }
+
+    return result;
+}
+
+QStringList CommandLineBuilder::toArguments() const{
+    QStringList result;
+    result.reserve(arguments.size());
+
+    // no quotes here, QProcess passes each argument as is
+    for(const Argument &currArgument : arguments){
+        result << buffer.mid(currArgument.offset, currArgument.size);
+    }
+
+    return result;
+}
+
 #ifdef QT_GUI_LIB
 QRect getScreenResolution(){
     return qApp->primaryScreen()->availableGeometry();
@@ -413,7 +3874,7 @@ QRect getScreenResolution(){
 namespace TableWidget {
 
 
-void addRow(QTableWidget *myTable, QStringList &columns){
+void addRow(QTableWidget *myTable, const QStringList &columns){
     //Get actual number rows
     int twSize=myTable->rowCount();
 
@@ -423,31 +3884,161 @@ void addRow(QTableWidget *myTable, QStringList &columns){
     //Add to table and list to
     for(int i=0; i<columns.size(); i++){
         QTableWidgetItem *newColumn = new QTableWidgetItem(columns[i]);
-        myTable->setItem(twSize,i,newColumn);
         // Add a tooltip with with the cell content
-        myTable->item(twSize,i)->setToolTip(myTable->item(twSize,i)->text());
+        newColumn->setToolTip(columns[i]);
+        myTable->setItem(twSize,i,newColumn);
     }
 
 }
 
+namespace {
 
-QModelIndexList getSelectedRows(QTableWidget *myTable){
-    return myTable->selectionModel()->selectedRows();
+// Fills the already existing table rows [firstTableRow, firstTableRow + to - from[ with rows [from, to[
+void fillRows(QTableWidget *myTable, const QList<QStringList> &rows, const int from, const int to, const int firstTableRow){
+    // items are cloned from the table prototype, so custom prototypes are kept
+    const QTableWidgetItem defaultPrototype;
+    const QTableWidgetItem *prototype = myTable->itemPrototype() != nullptr ? myTable->itemPrototype() : &defaultPrototype;
+    const int columnCount = myTable->columnCount();
+
+    for(int i = from; i < to; i++){
+        const QStringList &currRow = rows.at(i);
+        const int currColumnCount = qMin(columnCount, currRow.size());
+
+        for(int j = 0; j < currColumnCount; j++){
+            QTableWidgetItem *newItem = prototype->clone();
+            newItem->setText(currRow.at(j));
+            newItem->setToolTip(currRow.at(j));
+            myTable->setItem(firstTableRow + i - from, j, newItem);
+        }
+    }
 }
 
-QModelIndexList getCurrentRows(QTableWidget *myTable){
+const char *const pendingChunkedLoadsProperty = "_util_pendingChunkedLoads";
+const char *const sortingBeforeChunkedLoadsProperty = "_util_sortingBeforeChunkedLoads";
+
+// Sorting stays off while chunked loads are in flight, the last one to end restores what was there before the first
+void beginChunkedLoad(QTableWidget *myTable){
+    const int pendingLoads = myTable->property(pendingChunkedLoadsProperty).toInt();
+
+    if(pendingLoads == 0){
+        myTable->setProperty(sortingBeforeChunkedLoadsProperty, myTable->isSortingEnabled());
+    }
+
+    myTable->setProperty(pendingChunkedLoadsProperty, pendingLoads + 1);
+    myTable->setSortingEnabled(false);
+}
+
+void endChunkedLoad(QTableWidget *myTable){
+    const int pendingLoads = myTable->property(pendingChunkedLoadsProperty).toInt() - 1;
+
+    myTable->setProperty(pendingChunkedLoadsProperty, pendingLoads);
 
-    QModelIndexList oldSelection = getSelectedRows(myTable);
+    if(pendingLoads == 0){
+        myTable->setSortingEnabled(myTable->property(sortingBeforeChunkedLoadsProperty).toBool());
+    }
+}
+
+struct ChunkedLoad{
+    bool isCanceled = false;
+    QList<QMetaObject::Connection> connections;
+};
+
+}
+
+// Updates and sorting are suspended and the table is resized only once
+// With chunkSize > 0 the rows are filled chunkSize at a time from the event loop, so the UI keeps responding
+// A chunked load stops (leaving its remaining rows empty) if the table is cleared, sorted or rows are added or removed before its own
+void addRows(QTableWidget *myTable, const QList<QStringList> &rows, const int chunkSize){
+    if(rows.isEmpty()){
+        return;
+    }
+
+    const int firstTableRow = myTable->rowCount();
+    const int endTableRow = firstTableRow + rows.size();
+
+    // (sorting is already off if a chunked load is in flight, so it stays off until that one ends)
+    if(chunkSize <= 0 || rows.size() <= chunkSize){
+        const bool wasSortingEnabled = myTable->isSortingEnabled();
+
+        myTable->setSortingEnabled(false);
+        myTable->setUpdatesEnabled(false);
+        myTable->setRowCount(endTableRow);
+        fillRows(myTable, rows, 0, rows.size(), firstTableRow);
+        myTable->setUpdatesEnabled(true);
+        myTable->setSortingEnabled(wasSortingEnabled);
+        return;
+    }
+
+    beginChunkedLoad(myTable);
+    myTable->setRowCount(endTableRow);
+
+    // anything changing the rows reserved here means they aren't ours to fill anymore
+    const std::shared_ptr<ChunkedLoad> load = std::make_shared<ChunkedLoad>();
+    const QAbstractItemModel *model = myTable->model();
+
+    const auto cancel = [load](){
+        load->isCanceled = true;
+    };
+    const auto cancelIfBefore = [load, endTableRow](const QModelIndex &, const int first, const int){
+        if(first < endTableRow){
+            load->isCanceled = true;
+        }
+    };
+
+    load->connections << QObject::connect(model, &QAbstractItemModel::modelReset, myTable, cancel)
+                      << QObject::connect(model, &QAbstractItemModel::layoutChanged, myTable, cancel)
+                      << QObject::connect(model, &QAbstractItemModel::rowsMoved, myTable, cancel)
+                      << QObject::connect(model, &QAbstractItemModel::rowsRemoved, myTable, cancelIfBefore)
+                      << QObject::connect(model, &QAbstractItemModel::rowsInserted, myTable, cancelIfBefore);
+
+    // the table is the timer context, so nothing runs if it is destroyed meanwhile
+    std::shared_ptr<std::function<void(int)>> fillChunk = std::make_shared<std::function<void(int)>>();
+    std::weak_ptr<std::function<void(int)>> weakFillChunk = fillChunk;
+
+    *fillChunk = [myTable, rows, chunkSize, firstTableRow, load, weakFillChunk](const int from){
+        const int to = qMin(rows.size(), from + chunkSize);
+
+        if(!load->isCanceled && firstTableRow + to <= myTable->rowCount()){
+            myTable->setUpdatesEnabled(false);
+            fillRows(myTable, rows, from, to, firstTableRow + from);
+            myTable->setUpdatesEnabled(true);
+
+            if(to < rows.size()){
+                const std::shared_ptr<std::function<void(int)>> nextChunk = weakFillChunk.lock();
+                QTimer::singleShot(0, myTable, [nextChunk, to](){
+                    (*nextChunk)(to);
+                });
+                return;
+            }
+        }
+
+        for(const QMetaObject::Connection &currConnection : load->connections){
+            QObject::disconnect(currConnection);
+        }
 
-    myTable->selectAll();
+        endChunkedLoad(myTable);
+    };
+
+    QTimer::singleShot(0, myTable, [fillChunk](){
+        (*fillChunk)(0);
+    });
+}
+
+
+QModelIndexList getSelectedRows(QTableWidget *myTable){
+    return myTable->selectionModel()->selectedRows();
+}
 
-    QModelIndexList allRows = getSelectedRows(myTable);
+// The first column index of every row (like selectedRows() would return with all rows selected)
+QModelIndexList getCurrentRows(QTableWidget *myTable){
+    QAbstractItemModel *model = myTable->model();
+    const int rowCount = model->rowCount();
 
-    myTable->selectionModel()->clearSelection();
+    QModelIndexList allRows;
+    allRows.reserve(rowCount);
 
-    // Restore old selection
-    for(const QModelIndex &currentIndex : oldSelection){
-        myTable->selectionModel()->select(currentIndex, QItemSelectionModel::Select | QItemSelectionModel::SelectionFlag::Rows);
+    for(int i = 0; i < rowCount; i++){
+        allRows << model->index(i, 0);
     }
 
     return allRows;
@@ -538,12 +4129,456 @@ void swapRows(QTableWidget *myTable, const int indexSourceRow, const int indexDe
     }
 }
 
+// The selected rows are collapsed into contiguous ranges, which are removed bottom-up with a single removeRows each
 void deleteSelectedRows(QTableWidget *myTable){
-    int size = myTable->selectionModel()->selectedRows().size();
+    const QModelIndexList selectedRows = getSelectedRows(myTable);
+
+    if(selectedRows.isEmpty()){
+        return;
+    }
+
+    QVector<int> rows;
+    rows.reserve(selectedRows.size());
+
+    for(const QModelIndex &currIndex : selectedRows){
+        rows << currIndex.row();
+    }
+
+    std::sort(rows.begin(), rows.end());
+
+    myTable->setUpdatesEnabled(false);
+
+    int rangeEnd = rows.size() - 1;
+
+    while(rangeEnd >= 0){
+        int rangeStart = rangeEnd;
+
+        while(rangeStart > 0 && rows.at(rangeStart - 1) >= rows.at(rangeStart) - 1){
+            rangeStart--;
+        }
+
+        myTable->model()->removeRows(rows.at(rangeStart), rows.at(rangeEnd) - rows.at(rangeStart) + 1);
+
+        rangeEnd = rangeStart - 1;
+    }
+
+    myTable->setUpdatesEnabled(true);
+}
+
+CheckBoxDelegate::CheckBoxDelegate(QObject *parent) : QStyledItemDelegate(parent){
+}
+
+QRect CheckBoxDelegate::checkBoxRect(const QStyleOptionViewItem &option, const QModelIndex &index) const{
+    const QStyle *style = option.widget != nullptr ? option.widget->style() : QApplication::style();
+
+    QStyleOptionViewItem itemOption = option;
+    initStyleOption(&itemOption, index);
+
+    if(!itemOption.text.isEmpty()){
+        // before the text, where the style puts the check indicator of a checkable item
+        return style->subElementRect(QStyle::SE_ItemViewItemCheckIndicator, &itemOption, option.widget);
+    }
+
+    QStyleOptionButton checkBoxOption;
+    const QRect indicatorRect = style->subElementRect(QStyle::SE_CheckBoxIndicator, &checkBoxOption, option.widget);
+
+    // centered in the cell, like addCheckBox layout does
+    return QStyle::alignedRect(option.direction, Qt::AlignCenter, indicatorRect.size(), option.rect);
+}
+
+void CheckBoxDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const{
+    const QStyle *style = option.widget != nullptr ? option.widget->style() : QApplication::style();
+
+    QStyleOptionViewItem itemOption = option;
+    initStyleOption(&itemOption, index);
+
+    if(!itemOption.text.isEmpty()){
+        // cells with text keep it, the base delegate draws it with the indicator before it
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    // the cell background (selection, focus...) with the indicator centered on top
+    itemOption.features &= ~QStyleOptionViewItem::HasCheckIndicator;
+    style->drawControl(QStyle::CE_ItemViewItem, &itemOption, painter, option.widget);
+
+    QStyleOptionButton checkBoxOption;
+    checkBoxOption.rect = checkBoxRect(option, index);
+    checkBoxOption.state = option.state & QStyle::State_Enabled;
+    checkBoxOption.state |= index.data(Qt::CheckStateRole).toInt() == Qt::Checked ? QStyle::State_On : QStyle::State_Off;
+    style->drawPrimitive(QStyle::PE_IndicatorCheckBox, &checkBoxOption, painter, option.widget);
+}
+
+bool CheckBoxDelegate::editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option, const QModelIndex &index){
+    if(!(index.flags() & Qt::ItemIsEnabled)){
+        return false;
+    }
+
+    if(event->type() == QEvent::MouseButtonRelease){
+        const QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+        if(mouseEvent->button() != Qt::LeftButton || !checkBoxRect(option, index).contains(mouseEvent->pos())){
+            return false;
+        }
+    }
+    else if(event->type() == QEvent::MouseButtonDblClick){
+        return true; // don't open an editor
+    }
+    else if(event->type() == QEvent::KeyPress){
+        const int key = static_cast<QKeyEvent*>(event)->key();
+        if(key != Qt::Key_Space && key != Qt::Key_Select){
+            return false;
+        }
+    }
+    else{
+        return false;
+    }
+
+    const bool isChecked = index.data(Qt::CheckStateRole).toInt() == Qt::Checked;
+    return model->setData(index, isChecked ? Qt::Unchecked : Qt::Checked, Qt::CheckStateRole);
+}
+
+QWidget* CheckBoxDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const{
+    Q_UNUSED(parent);
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+
+    return nullptr; // toggled in editorEvent
+}
+
+void setCheckBoxColumn(QTableWidget *myTable, int column){
+    myTable->setItemDelegateForColumn(column, new CheckBoxDelegate(myTable));
+}
+
+bool isCellChecked(QTableWidget *myTable, int row, int column){
+    const QTableWidgetItem *item = myTable->item(row, column);
+    return item != nullptr && item->checkState() == Qt::Checked;
+}
+
+void setCellChecked(QTableWidget *myTable, int row, int column, bool isChecked){
+    QTableWidgetItem *item = myTable->item(row, column);
+
+    if(item == nullptr){
+        item = new QTableWidgetItem();
+        myTable->setItem(row, column, item);
+    }
+
+    item->setCheckState(isChecked ? Qt::Checked : Qt::Unchecked);
+}
+// Sorting and repaints are suspended while the items change, so the rows stay put and the view repaints once at the end
+// The model signals are blocked while the items change, the view gets a single dataChanged for the whole range
+void setCheckedRange(QTableWidget *myTable, int firstRow, int lastRow, int column, bool isChecked){
+    if(firstRow > lastRow){
+        return;
+    }
+
+    // the rows would be resorted after each change otherwise, moving the ones not set yet
+    const bool wasSortingEnabled = myTable->isSortingEnabled();
+
+    myTable->setSortingEnabled(false);
+    myTable->setUpdatesEnabled(false);
+
+    for(int i = firstRow; i <= lastRow; i++){
+        setCellChecked(myTable, i, column, isChecked);
+    }
+
+    myTable->setUpdatesEnabled(true);
+    myTable->setSortingEnabled(wasSortingEnabled);
+}
+
+ColumnarTableModel::ColumnarTableModel(const QStringList &headers, QObject *parent) : QAbstractTableModel(parent), headers(headers), columns(size_t(headers.size())){
+}
+
+int ColumnarTableModel::rowCount(const QModelIndex &parent) const{
+    return parent.isValid() ? 0 : rows;
+}
+
+int ColumnarTableModel::columnCount(const QModelIndex &parent) const{
+    return parent.isValid() ? 0 : int(columns.size());
+}
+
+QVariant ColumnarTableModel::data(const QModelIndex &index, int role) const{
+    if(!index.isValid()){
+        return QVariant();
+    }
+
+    switch(role){
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+    case Qt::ToolTipRole:
+        return text(index.row(), index.column());
+    case Qt::CheckStateRole:
+        if(isCheckBoxColumn(index.column())){
+            return isChecked(index.row(), index.column()) ? Qt::Checked : Qt::Unchecked;
+        }
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+bool ColumnarTableModel::setData(const QModelIndex &index, const QVariant &value, int role){
+    if(!index.isValid()){
+        return false;
+    }
+
+    if(role == Qt::CheckStateRole && isCheckBoxColumn(index.column())){
+        setChecked(index.row(), index.column(), value.toInt() == Qt::Checked);
+        return true;
+    }
+
+    if(role == Qt::EditRole || role == Qt::DisplayRole){
+        setText(index.row(), index.column(), value.toString());
+        return true;
+    }
+
+    return false;
+}
+
+QVariant ColumnarTableModel::headerData(int section, Qt::Orientation orientation, int role) const{
+    if(orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < headers.size()){
+        return headers.at(section);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+Qt::ItemFlags ColumnarTableModel::flags(const QModelIndex &index) const{
+    Qt::ItemFlags result = QAbstractTableModel::flags(index);
+
+    if(index.isValid() && isCheckBoxColumn(index.column())){
+        result |= Qt::ItemIsUserCheckable;
+    }
+
+    return result;
+}
+
+bool ColumnarTableModel::removeRows(int row, int count, const QModelIndex &parent){
+    if(parent.isValid() || row < 0 || count <= 0 || row + count > rows){
+        return false;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+
+    for(Column &currColumn : columns){
+        for(int i = row; i < row + count; i++){
+            currColumn.garbageChars += currColumn.sizes[size_t(i)];
+        }
+
+        currColumn.starts.erase(currColumn.starts.begin() + row, currColumn.starts.begin() + row + count);
+        currColumn.sizes.erase(currColumn.sizes.begin() + row, currColumn.sizes.begin() + row + count);
+
+        if(currColumn.isCheckBoxColumn){
+            currColumn.checked.erase(currColumn.checked.begin() + row, currColumn.checked.begin() + row + count);
+        }
+
+        compact(currColumn);
+    }
+
+    rows -= count;
+
+    endRemoveRows();
+
+    return true;
+}
+
+bool ColumnarTableModel::isValidCell(int row, int column) const{
+    return row >= 0 && row < rows && column >= 0 && column < int(columns.size());
+}
+
+QString ColumnarTableModel::text(int row, int column) const{
+    if(!isValidCell(row, column)){
+        return QString();
+    }
+
+    const Column &currColumn = columns[size_t(column)];
+    return QString(reinterpret_cast<const QChar*>(currColumn.chars.data() + currColumn.starts[size_t(row)]), int(currColumn.sizes[size_t(row)]));
+}
+
+void ColumnarTableModel::setText(int row, int column, const QString &text){
+    if(!isValidCell(row, column)){
+        return;
+    }
+
+    Column &currColumn = columns[size_t(column)];
 
-    for(int i=0; i<size; i++){
-        myTable->removeRow(myTable->selectionModel()->selectedRows().at(size-i-1).row());
+    // the new text goes to the end of the buffer, the old one becomes garbage
+    currColumn.garbageChars += currColumn.sizes[size_t(row)];
+    currColumn.starts[size_t(row)] = quint32(currColumn.chars.size());
+    currColumn.sizes[size_t(row)] = quint32(text.size());
+    currColumn.chars.insert(currColumn.chars.end(), text.utf16(), text.utf16() + text.size());
+
+    compact(currColumn);
+
+    const QModelIndex changedIndex = index(row, column);
+    emit dataChanged(changedIndex, changedIndex);
+}
+
+void ColumnarTableModel::appendText(Column &column, const QString &text){
+    column.starts.push_back(quint32(column.chars.size()));
+    column.sizes.push_back(quint32(text.size()));
+    column.chars.insert(column.chars.end(), text.utf16(), text.utf16() + text.size());
+
+    if(column.isCheckBoxColumn){
+        column.checked.push_back(0);
+    }
+}
+
+// Rebuilds the buffer once more than half of it is garbage
+void ColumnarTableModel::compact(Column &column){
+    if(column.garbageChars <= column.chars.size() / 2){
+        return;
+    }
+
+    std::vector<ushort> compactedChars;
+    compactedChars.reserve(column.chars.size() - column.garbageChars);
+
+    for(size_t i = 0; i < column.starts.size(); i++){
+        const quint32 newStart = quint32(compactedChars.size());
+        compactedChars.insert(compactedChars.end(), column.chars.begin() + column.starts[i], column.chars.begin() + column.starts[i] + column.sizes[i]);
+        column.starts[i] = newStart;
+    }
+
+    column.chars.swap(compactedChars);
+    column.garbageChars = 0;
+}
+
+void ColumnarTableModel::addRow(const QStringList &newRow){
+    addRows(QList<QStringList>() << newRow);
+}
+
+// A single rowsInserted for all the rows, missing columns are left empty
+void ColumnarTableModel::addRows(const QList<QStringList> &newRows){
+    if(newRows.isEmpty()){
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), rows, rows + newRows.size() - 1);
+
+    for(size_t j = 0; j < columns.size(); j++){
+        Column &currColumn = columns[j];
+
+        currColumn.starts.reserve(currColumn.starts.size() + size_t(newRows.size()));
+        currColumn.sizes.reserve(currColumn.sizes.size() + size_t(newRows.size()));
+
+        for(const QStringList &currRow : newRows){
+            appendText(currColumn, int(j) < currRow.size() ? currRow.at(int(j)) : QString());
+        }
+    }
+
+    rows += newRows.size();
+
+    endInsertRows();
+}
+
+void ColumnarTableModel::swapRows(const int indexSourceRow, const int indexDestinationRow){
+    if(!isValidCell(indexSourceRow, 0) || !isValidCell(indexDestinationRow, 0) || indexSourceRow == indexDestinationRow){
+        return;
+    }
+
+    for(Column &currColumn : columns){
+        std::swap(currColumn.starts[size_t(indexSourceRow)], currColumn.starts[size_t(indexDestinationRow)]);
+        std::swap(currColumn.sizes[size_t(indexSourceRow)], currColumn.sizes[size_t(indexDestinationRow)]);
+
+        if(currColumn.isCheckBoxColumn){
+            std::swap(currColumn.checked[size_t(indexSourceRow)], currColumn.checked[size_t(indexDestinationRow)]);
+        }
+    }
+
+    emit dataChanged(index(indexSourceRow, 0), index(indexSourceRow, columnCount() - 1));
+    emit dataChanged(index(indexDestinationRow, 0), index(indexDestinationRow, columnCount() - 1));
+}
+
+// Same as TableWidget::deleteSelectedRows, contiguous rows are removed as a range
+void ColumnarTableModel::deleteSelectedRows(const QItemSelectionModel *selectionModel){
+    QVector<int> selectedRows;
+
+    for(const QModelIndex &currIndex : selectionModel->selectedRows()){
+        selectedRows << currIndex.row();
+    }
+
+    std::sort(selectedRows.begin(), selectedRows.end());
+
+    int rangeEnd = selectedRows.size() - 1;
+
+    while(rangeEnd >= 0){
+        int rangeStart = rangeEnd;
+
+        while(rangeStart > 0 && selectedRows.at(rangeStart - 1) >= selectedRows.at(rangeStart) - 1){
+            rangeStart--;
+        }
+
+        removeRows(selectedRows.at(rangeStart), selectedRows.at(rangeEnd) - selectedRows.at(rangeStart) + 1);
+
+        rangeEnd = rangeStart - 1;
+    }
+}
+
+void ColumnarTableModel::clear(){
+    beginResetModel();
+
+    for(Column &currColumn : columns){
+        std::vector<ushort>().swap(currColumn.chars);
+        std::vector<quint32>().swap(currColumn.starts);
+        std::vector<quint32>().swap(currColumn.sizes);
+        std::vector<quint8>().swap(currColumn.checked);
+        currColumn.garbageChars = 0;
+    }
+
+    rows = 0;
+
+    endResetModel();
+}
+
+void ColumnarTableModel::setCheckBoxColumn(int column, bool isCheckBoxColumn){
+    if(column < 0 || column >= int(columns.size())){
+        return;
+    }
+
+    Column &currColumn = columns[size_t(column)];
+
+    currColumn.isCheckBoxColumn = isCheckBoxColumn;
+    currColumn.checked.assign(isCheckBoxColumn ? size_t(rows) : 0, 0);
+
+    if(rows > 0){
+        emit dataChanged(index(0, column), index(rows - 1, column));
+    }
+}
+
+bool ColumnarTableModel::isCheckBoxColumn(int column) const{
+    if(column < 0 || column >= int(columns.size())){
+        return false;
+    }
+
+    return columns[size_t(column)].isCheckBoxColumn;
+}
+
+bool ColumnarTableModel::isChecked(int row, int column) const{
+    if(!isValidCell(row, column)){
+        return false;
+    }
+
+    const Column &currColumn = columns[size_t(column)];
+    return currColumn.isCheckBoxColumn && currColumn.checked[size_t(row)] != 0;
+}
+
+void ColumnarTableModel::setChecked(int row, int column, bool isChecked){
+    setCheckedRange(row, row, column, isChecked);
+}
+
+// A single dataChanged for the whole range (clamped to the existing rows)
+void ColumnarTableModel::setCheckedRange(int firstRow, int lastRow, int column, bool isChecked){
+    firstRow = qMax(firstRow, 0);
+    lastRow = qMin(lastRow, rows - 1);
+
+    if(!isCheckBoxColumn(column) || firstRow > lastRow){
+        return;
     }
+
+    Column &currColumn = columns[size_t(column)];
+
+    std::fill(currColumn.checked.begin() + firstRow, currColumn.checked.begin() + lastRow + 1, isChecked ? 1 : 0);
+
+    emit dataChanged(index(firstRow, column), index(lastRow, column), QVector<int>() << Qt::CheckStateRole);
 }
 
 }
@@ -552,31 +4587,127 @@ void deleteSelectedRows(QTableWidget *myTable){
 #ifdef QT_GUI_LIB
 namespace StatusBar {
 
-void showInfo(QStatusBar * const statusBar, const QString &message){
+namespace {
 
-    QPalette myPalete = QPalette();
-    myPalete.setColor( QPalette::WindowText, QColor(0,38,255));
-    statusBar->setPalette( myPalete );
-    statusBar->showMessage(message,10000); //display by 10 seconds
+// Built once, setPalette restyles the whole status bar so it is skipped when the color is already the same
+const QPalette &messagePalette(const QColor &color){
+    static QHash<QRgb, QPalette> palettes;
 
+    QHash<QRgb, QPalette>::iterator currPalette = palettes.find(color.rgb());
+
+    if(currPalette == palettes.end()){
+        QPalette newPalette;
+        newPalette.setColor(QPalette::WindowText, color);
+        currPalette = palettes.insert(color.rgb(), newPalette);
+    }
+
+    return *currPalette;
 }
 
-void showError(QStatusBar * const statusBar, const QString &message){
+const QColor infoColor(0,38,255);
+const QColor errorColor(255,0,0);
+const QColor successColor(0,150,0);
 
-    QPalette myPalete = QPalette();
-    myPalete.setColor( QPalette::WindowText, QColor(255,0,0));
-    statusBar->setPalette( myPalete );
+void showMessage(QStatusBar * const statusBar, const QString &message, const QColor &color){
+    if(statusBar->palette().color(QPalette::WindowText) != color){
+        statusBar->setPalette(messagePalette(color));
+    }
     statusBar->showMessage(message,10000); //display by 10 seconds
+}
+
+}
 
+void showInfo(QStatusBar * const statusBar, const QString &message){
+    showMessage(statusBar, message, infoColor);
+}
+
+void showError(QStatusBar * const statusBar, const QString &message){
+    showMessage(statusBar, message, errorColor);
 }
 
 void showSuccess(QStatusBar * const statusBar,const QString &message){
+    showMessage(statusBar, message, successColor);
+}
 
-    QPalette myPalete = QPalette();
-    myPalete.setColor( QPalette::WindowText, QColor(0,150,0));
-    statusBar->setPalette( myPalete );
-    statusBar->showMessage(message,10000); //display by 10 seconds
+StatusBarChannel::StatusBarChannel(QStatusBar *statusBar, int maxUpdatesPerSecond)
+    : QObject(statusBar), statusBar(statusBar), flushInterval(1000 / qMax(1, maxUpdatesPerSecond)), flushTimer(new QTimer(this)){
+
+    flushTimer->setSingleShot(true);
+    connect(flushTimer, SIGNAL(timeout()), this, SLOT(flush()));
+
+    hasPendingMessage[0] = hasPendingMessage[1] = hasPendingMessage[2] = false;
+}
+
+void StatusBarChannel::post(Severity severity, const QString &message){
+    QMutexLocker locker(&pendingMutex);
+
+    pendingMessages[int(severity)] = message;
+    hasPendingMessage[int(severity)] = true;
+
+    if(isFlushScheduled){
+        return; // the pending flush will show it
+    }
+
+    isFlushScheduled = true;
+    locker.unlock();
+
+    // the timer can only be started from the GUI thread
+    QMetaObject::invokeMethod(this, [this](){ scheduleFlush(); }, Qt::QueuedConnection);
+}
+
+void StatusBarChannel::postInfo(const QString &message){
+    post(Severity::Info, message);
+}
+
+void StatusBarChannel::postSuccess(const QString &message){
+    post(Severity::Success, message);
+}
 
+void StatusBarChannel::postError(const QString &message){
+    post(Severity::Error, message);
+}
+
+void StatusBarChannel::scheduleFlush(){
+    const qint64 elapsed = sinceLastFlush.isValid() ? sinceLastFlush.elapsed() : flushInterval;
+    flushTimer->start(int(qMax(qint64(0), flushInterval - elapsed)));
+}
+
+void StatusBarChannel::flush(){
+    QString message;
+    Severity severity = Severity::Info;
+
+    {
+        QMutexLocker locker(&pendingMutex);
+
+        for(int i = 2; i >= 0; i--){
+            if(hasPendingMessage[i]){
+                message = pendingMessages[i];
+                severity = Severity(i);
+                break;
+            }
+        }
+
+        for(int i = 0; i < 3; i++){
+            pendingMessages[i].clear();
+            hasPendingMessage[i] = false;
+        }
+
+        isFlushScheduled = false;
+    }
+
+    sinceLastFlush.start();
+
+    switch(severity){
+    case Severity::Info:
+        showInfo(statusBar, message);
+        break;
+    case Severity::Success:
+        showSuccess(statusBar, message);
+        break;
+    case Severity::Error:
+        showError(statusBar, message);
+        break;
+    }
 }
 
 }
@@ -9,9 +9,21 @@
 #ifndef UTIL_H
 #define UTIL_H
 
+#include <QObject>
 #include <QString>
+#include <QStringView>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QBitArray>
 #include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QFuture>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #ifdef QT_GUI_LIB
 #include <QMessageBox>
@@ -19,6 +31,12 @@
 #include <QDesktopServices>
 #include <QStatusBar>
 #include <QTableWidget>
+#include <QAbstractTableModel>
+#include <QItemSelectionModel>
+#include <QStyledItemDelegate>
+#include <QTimer>
+#include <QMutex>
+#include <QElapsedTimer>
 #endif
 
 /**
@@ -28,28 +46,296 @@ namespace Util{
 
 namespace FileSystem {
 
+// Optional counters and phase timings of the FileSystem operations
+// Disabled by default, while disabled each hook is just a relaxed atomic load
+namespace Instrumentation {
+
+struct PhaseStats{
+    qint64 calls = 0;
+    qint64 totalNanoseconds = 0;
+};
+
+struct Snapshot{
+    quint64 filesVisited = 0;
+    quint64 bytesRead = 0;
+    quint64 bytesWritten = 0;
+    quint64 syscalls = 0; // the ones issued directly by these functions (not the ones done inside Qt)
+    quint64 errors = 0;
+    QMap<QString, PhaseStats> phases;
+};
+
+void setEnabled(bool enabled);
+bool isEnabled();
+void reset();
+Snapshot snapshot();
+QByteArray toChromeTraceJson();
+
+}
+
 QString normalizePath(QString path);
+void normalizePathInPlace(QString &path);
+void normalizePaths(QStringList &paths);
 
 QString cutName(QString path);
 
 QString cutNameWithoutBackSlash(QString path);
 
+// The name after the last slash as a view into path, without the quotes at its ends
+QStringView cutNameView(QStringView path);
+QVector<QStringView> cutNameViews(const QStringList &paths);
+
 QString normalizeAndQuote(QString path);
 
+struct CopyFileError{
+    QString sourcePath;
+    QString destinationPath;
+    QString errorString;
+};
+
+// How files are copied when they don't need to be modified afterwards (e.g. snapshots / backups)
+enum class CloneMode{
+    Disabled, // always a full copy
+    Reflink, // copy-on-write clone (btrfs, xfs...) when supported, full copy otherwise
+    ReflinkOrHardLink // a hardlink when possible (both files will share the same data!), as Reflink otherwise
+};
+
+enum class CopyStrategy{
+    Failed,
+    Reflink,
+    HardLink,
+    FullCopy
+};
+
+struct CopiedFile{
+    QString sourcePath;
+    QString destinationPath;
+    CopyStrategy strategy;
+};
+
+struct CopyDirOptions{
+    bool isRecursive = false;
+    int maxThreads = 0; // 0 = QThread::idealThreadCount()
+    CloneMode cloneMode = CloneMode::Disabled;
+    // optional, called from the worker threads (progress calls from different workers can overlap)
+    std::function<bool()> isCanceled;
+    std::function<void(qint64 filesDone, qint64 filesFound)> progress;
+};
+
+struct CopyDirResult{
+    int filesCopied = 0;
+    qint64 bytesCopied = 0;
+    QList<CopiedFile> copiedFiles;
+    QList<CopyFileError> errors;
+    bool wasCanceled = false; // some files or folders were left uncopied by isCanceled (not just canceled after the end)
+
+    bool success() const { return errors.isEmpty() && !wasCanceled; }
+};
+
 bool copyDir(const QString &fromPath, QString toPath, const bool isRecursive = false);
 
+CopyDirResult copyDir(const QString &fromPath, const QString &toPath, const CopyDirOptions &options);
+
+CopyStrategy copyFile(const QString &sourcePath, const QString &destinationPath, const CloneMode cloneMode = CloneMode::Disabled, QString *errorString = nullptr);
+
+struct RmDirOptions{
+    int maxThreads = 0; // 0 = QThread::idealThreadCount()
+    // renames the folder and removes it in a background thread, so the call returns right away
+    bool deleteInBackground = false;
+    // optional, called from the worker threads
+    std::function<bool()> isCanceled;
+    std::function<void(qint64 entriesRemoved, qint64 entriesFound)> progress;
+};
+
+struct RmDirError{
+    QString path;
+    QString errorString;
+};
+
+struct RmDirResult{
+    qint64 entriesRemoved = 0;
+    QString backgroundPath; // renamed folder still being removed (only with deleteInBackground)
+    QList<RmDirError> errors;
+    bool wasCanceled = false;
+
+    bool success() const { return errors.isEmpty() && !wasCanceled; }
+};
+
 bool rmDir(const QString &dirPath);
 
+// A symlink to a folder is removed without touching the folder (the same in Util::Std::FileSystem::rmDir)
+RmDirResult rmDir(const QString &dirPath, const RmDirOptions &options);
+
 QStringList getFolderFilesByWildcard(const QString &entryFolder, const QString &wildcard, bool isRecursive = false);
 
+// Compiled form of one or more wildcards (same rules as filterFilesByWildcard) that doesn't use regular expressions
+// All the wildcards are matched in a single pass over the path. It isn't changed after built, so it can be cached
+// and shared between threads.
+class WildcardMatcher{
+public:
+    WildcardMatcher();
+    explicit WildcardMatcher(const QString &wildcard);
+    explicit WildcardMatcher(const QStringList &wildcards);
+
+    bool isEmpty() const; // true if there isn't any non empty wildcard
+    bool matches(const QString &filePath) const;
+    int matchIndex(const QString &filePath) const; // index of the first matching wildcard, -1 if none
+
+private:
+    void compile(const QStringList &wildcards);
+
+    int stateWords = 0;
+    std::vector<quint64> rows; // for each char, the positions that can move on when reading it
+    int asciiRows[128];
+    QHash<uint, int> otherRows;
+    std::vector<quint64> starMask;
+    std::vector<quint64> initialStates;
+    std::vector<quint64> acceptStates;
+    std::vector<int> acceptPositions; // for each wildcard (-1 if empty)
+};
+
+QStringList filterFilesByWildcard(const QStringList &filePaths, const QStringList &wildcards);
+
+QStringList filterFilesByWildcard(const QStringList &filePaths, const WildcardMatcher &matcher);
+
+bool forEachFileByWildcard(const QString &entryFolder, const QString &wildcard, bool isRecursive, const std::function<bool(const QString &filePath)> &callback);
+
+// Same matches as getFolderFilesByWildcard, but found while the folder is walked (nothing else is kept in memory)
+class WildcardFileIterator{
+public:
+    WildcardFileIterator(const QString &entryFolder, const QString &wildcard, bool isRecursive = false);
+    ~WildcardFileIterator();
+
+    bool hasNext() const;
+    QString next();
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+
+    Q_DISABLE_COPY(WildcardFileIterator)
+};
+
 QStringList filterFilesByWildcard(const QStringList &filePaths, const QString &wildcard);
 
+// The files under a folder kept in memory (same entries as getFolderFilesByWildcard), so wildcard queries don't touch the disk
+// It is kept up to date with inotify (QFileSystemWatcher when not available, which doesn't report fileModified)
+class FileIndex : public QObject{
+    Q_OBJECT
+public:
+    explicit FileIndex(const QString &rootPath, QObject *parent = nullptr);
+    ~FileIndex();
+
+    QString rootPath() const;
+    bool isUsingInotify() const;
+    int fileCount() const;
+
+    QStringList filesByWildcard(const QString &wildcard, bool isRecursive = false) const;
+
+public slots:
+    void resync();
+
+signals:
+    void fileAdded(const QString &filePath);
+    void fileRemoved(const QString &filePath);
+    void fileModified(const QString &filePath);
+    void overflowed(); // some changes were lost or a folder couldn't be watched, call resync()
+    void resynced();
+
+private slots:
+    void readInotifyEvents();
+    void folderChanged(const QString &folderPath);
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+
 QString fileHash(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm);
 
+struct FileHashResult{
+    QString fileName;
+    QString hash; // hex, empty on error
+    QString errorString;
+
+    bool success() const { return errorString.isEmpty(); }
+};
+
+QVector<FileHashResult> fileHashes(const QStringList &fileNames, QCryptographicHash::Algorithm hashAlgorithm, const std::function<void(const FileHashResult &result)> &onResult = nullptr, int maxThreads = 0);
+
+// Digests saved on disk, keyed by (path, size, modification and change times, inode, algorithm), so unchanged files aren't read again
+// Files modified in the last seconds are hashed but not cached, a later write in the same timestamp tick couldn't be told apart
+// Several threads and processes can use the same cache file (saves are atomic and merge what is on disk, except entries removed or cleared here)
+class FileHashCache{
+public:
+    explicit FileHashCache(const QString &cacheFilePath);
+    ~FileHashCache();
+
+    bool load();
+    bool save();
+    int removeStaleEntries();
+    void clear();
+    int size() const;
+
+    QString fileHash(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm);
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+
+    Q_DISABLE_COPY(FileHashCache)
+};
+
+// Merkle tree with the hashes of a folder, its subfolders and files (relative paths, "" is the root folder)
+// Comparing it with a previous tree tells which subtrees changed, without reading them again
+class DirectoryHashTree{
+public:
+    DirectoryHashTree();
+
+    static DirectoryHashTree build(const QString &rootPath, QCryptographicHash::Algorithm hashAlgorithm, int maxThreads = 0, FileHashCache *cache = nullptr);
+
+    bool isEmpty() const;
+    QByteArray rootHash() const;
+    QByteArray hash(const QString &relativePath) const;
+    QStringList changedPaths(const DirectoryHashTree &previous) const;
+    QList<FileHashResult> errors() const;
+
+    QByteArray toByteArray() const;
+    static DirectoryHashTree fromByteArray(const QByteArray &data, bool *ok = nullptr);
+
+private:
+    struct Node{
+        QByteArray hash;
+        bool isDir;
+        QStringList children; // names
+
+        Node() : isDir(false){}
+    };
+
+    QCryptographicHash::Algorithm algorithm;
+    QHash<QString, Node> nodes;
+    QList<FileHashResult> errorList;
+};
+
+// Async versions of the long running calls, they run in a shared thread pool and can be canceled through the QFuture
+void setAsyncMaxThreadCount(int maxThreads);
+int asyncMaxThreadCount();
+
+QFuture<CopyDirResult> copyDirAsync(const QString &fromPath, const QString &toPath, const CopyDirOptions &options = CopyDirOptions());
+
+QFuture<RmDirResult> rmDirAsync(const QString &dirPath, const RmDirOptions &options = RmDirOptions());
+
+QFuture<QString> getFolderFilesByWildcardAsync(const QString &entryFolder, const QString &wildcard, bool isRecursive = false);
+
+QFuture<QString> fileHashAsync(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm);
+
+QFuture<FileHashResult> fileHashesAsync(const QStringList &fileNames, QCryptographicHash::Algorithm hashAlgorithm, int maxThreads = 0);
+
 QString getAppPath();
 
 bool backupFile(const QString &file, QString newFilename="");
 
+CopyStrategy backupFile(const QString &file, const QString &newFilename, const CloneMode cloneMode, QString *errorString = nullptr);
+
 }
 
 namespace String {
@@ -62,11 +348,74 @@ QString insertApostrophes(const QString &currString);
 
 QString insertQuotes(const QString &currString);
 
+// Removes all the whitespace
 QString fullTrim(QString str);
-
-QStringList substring(QString myString, QString separator, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+QString fullTrim(QStringView str);
+void fullTrimInPlace(QString &str);
+
+QStringList substring(const QString &myString, const QString &separator, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+// Lazy split, each token is a view into the text (no allocations), the text must outlive the tokenizer
+// e.g. for(StringTokenizer tokenizer(text, "\r\n"); tokenizer.hasNext();){ QStringView currLine = tokenizer.next(); }
+class StringTokenizer{
+public:
+    StringTokenizer(QStringView text, QStringView separator, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    bool hasNext() const;
+    // empty view once there are no more tokens
+    QStringView next();
+
+private:
+    QStringView text;
+    QStringView separator;
+    Qt::CaseSensitivity cs;
+    int currIdx; // -1 when done
+};
+
+// Eager split into views, the result is allocated only once
+QVector<QStringView> splitView(QStringView text, QStringView separator, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+// Search over views, Boyer-Moore-Horspool (SIMD scan for the first char of short case sensitive needles)
+// A negative from counts from the end, like in QString, and a from out of the text is clamped to it
+int indexOf(QStringView text, QStringView toSearch, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+int lastIndexOf(QStringView text, QStringView toSearch, int from = -1, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+//Searches for the QString "toSearch" in the "myString" variable backward, the match must end at or before "from" (-1 = the end)
+//Returns the index of the first match or -1 if not found
+int indexOfBackward(const QString &myString, const QString &toSearch, int from = -1);
+
+// Finds many keywords in a single pass over the text (Aho-Corasick)
+class MultiStringSearcher{
+public:
+    struct Match{
+        int position;
+        int keywordIndex;
+    };
+
+    explicit MultiStringSearcher(const QStringList &keywords, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    int keywordCount() const;
+
+    // every match (overlapping ones included) by end position, empty keywords never match
+    QVector<Match> findAll(QStringView text) const;
+    bool containsAny(QStringView text) const;
+    // stops when callback returns false, returns false if it was stopped
+    bool forEachMatch(QStringView text, const std::function<bool(int position, int keywordIndex)> &callback) const;
+
+private:
+    Qt::CaseSensitivity cs;
+    int classesPerState = 0;
+    int asciiClasses[128]; // chars are mapped to classes, so the transitions table only has the keywords chars
+    QHash<ushort, int> otherClasses;
+    std::vector<int> transitions; // for each state, the next state for each class
+    std::vector<int> outputs; // keyword ending in each state (-1 if none)
+    std::vector<int> outputLinks; // next state down the fail chain with an output (-1 if none)
+    std::vector<int> keywordLengths;
+};
 
 QString normalizeDecimalSeparator(QString value);
+void normalizeDecimalSeparatorInPlace(QString &value);
+void normalizeDecimalSeparators(QStringList &values);
 
 // no problem here with "temporary" cstr
 // https://stackoverflow.com/questions/1971183/when-does-c-allocate-deallocate-string-literals
@@ -94,18 +443,48 @@ QStringList multipleDirSelection(const QString &title);
 
 namespace Validation {
 
-bool checkEmptySpaces(QStringList toCheck);
-bool checkIfIntegers(QStringList toCheck);
-bool checkIfDoubles(QStringList toCheck);
-bool isStringInteger(QString myString);
-bool isStringDouble(QString myString);
+bool checkEmptySpaces(const QStringList &toCheck);
+bool checkIfIntegers(const QStringList &toCheck);
+bool checkIfDoubles(const QStringList &toCheck);
+bool isStringInteger(const QString &myString);
+bool isStringDouble(const QString &myString);
+
+// Index of the first element that isn't a valid integer / double (same rules as toInt / toDouble), -1 if all are
+// Big lists are checked by several threads (maxThreads 0 = QThread::idealThreadCount())
+int firstNonInteger(const QStringList &toCheck, int maxThreads = 0);
+int firstNonDouble(const QStringList &toCheck, int maxThreads = 0);
+
+// A column of numbers parsed in one pass, values[i] is only meaningful if validity.testBit(i) (NaN / 0 otherwise)
+struct DoubleColumn{
+    typedef double ValueType;
+    std::vector<double> values;
+    QBitArray validity;
+    int invalidCount = 0;
+};
+
+struct IntegerColumn{
+    typedef qint64 ValueType;
+    std::vector<qint64> values;
+    QBitArray validity;
+    int invalidCount = 0;
+};
+
+// Accepts both '.' and ',' as decimal separator (no need for normalizeDecimalSeparator first)
+DoubleColumn parseDoubleColumn(const QStringList &cells);
+DoubleColumn parseDoubleColumn(const QVector<QStringView> &cells);
+IntegerColumn parseIntegerColumn(const QStringList &cells);
+IntegerColumn parseIntegerColumn(const QVector<QStringView> &cells);
 
 }
 
 #ifdef QT_GUI_LIB
 namespace TableWidget {
 
-void addRow(QTableWidget *myTable, QStringList &columns);
+void addRow(QTableWidget *myTable, const QStringList &columns);
+// Updates and sorting are suspended and the table is resized once
+// With chunkSize > 0 the rows are filled chunkSize at a time from the event loop, so the UI keeps responding
+// (the load stops if the table is cleared, sorted or its rows removed meanwhile, sorting comes back once every load ended)
+void addRows(QTableWidget *myTable, const QList<QStringList> &rows, int chunkSize = 0);
 QModelIndexList getSelectedRows(QTableWidget *myTable);
 QModelIndexList getCurrentRows(QTableWidget *myTable);
 int getNumberSelectedRows(QTableWidget *myTable);
@@ -116,6 +495,76 @@ QCheckBox* getCheckBoxFromCell(QTableWidget *myTable, int row, int column);
 void swapRows(QTableWidget *myTable, const int indexSourceRow, const int indexDestinationRow, bool selectSwappedRow);
 void deleteSelectedRows(QTableWidget *myTable);
 
+// Checkbox painted by a delegate, with its state in the Qt::CheckStateRole of the cell (no widgets per cell like addCheckBox)
+// Centered in empty cells, cells with text show it after the checkbox
+class CheckBoxDelegate : public QStyledItemDelegate{
+public:
+    explicit CheckBoxDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option, const QModelIndex &index) override;
+    QWidget* createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    QRect checkBoxRect(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+};
+
+void setCheckBoxColumn(QTableWidget *myTable, int column);
+bool isCellChecked(QTableWidget *myTable, int row, int column);
+void setCellChecked(QTableWidget *myTable, int row, int column, bool isChecked);
+void setCheckedRange(QTableWidget *myTable, int firstRow, int lastRow, int column, bool isChecked);
+
+// A table model with the same operations as the helpers above, for tables too big for an item per cell
+// Each column keeps its texts back to back in a single buffer, the cells are only turned into QStrings when the view asks for them
+class ColumnarTableModel : public QAbstractTableModel{
+    Q_OBJECT
+public:
+    explicit ColumnarTableModel(const QStringList &headers, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+
+    QString text(int row, int column) const;
+    void setText(int row, int column, const QString &text);
+
+    void addRow(const QStringList &newRow);
+    void addRows(const QList<QStringList> &newRows);
+    void swapRows(const int indexSourceRow, const int indexDestinationRow);
+    void deleteSelectedRows(const QItemSelectionModel *selectionModel);
+    void clear();
+
+    // checkbox columns have a checkbox (Qt::CheckStateRole) besides their text
+    // (rows / columns out of range are ignored, and ranges clamped)
+    void setCheckBoxColumn(int column, bool isCheckBoxColumn = true);
+    bool isCheckBoxColumn(int column) const;
+    bool isChecked(int row, int column) const;
+    void setChecked(int row, int column, bool isChecked);
+    void setCheckedRange(int firstRow, int lastRow, int column, bool isChecked);
+
+private:
+    struct Column{
+        std::vector<ushort> chars; // all the texts, cells removed or replaced leave garbage behind until the next compact
+        std::vector<quint32> starts;
+        std::vector<quint32> sizes;
+        std::vector<quint8> checked; // only for checkbox columns
+        bool isCheckBoxColumn = false;
+        quint32 garbageChars = 0;
+    };
+
+    bool isValidCell(int row, int column) const;
+    void appendText(Column &column, const QString &text);
+    void compact(Column &column);
+
+    QStringList headers;
+    std::vector<Column> columns;
+    int rows = 0;
+};
+
 }
 #endif
 
@@ -123,6 +572,41 @@ namespace System {
 #ifdef QT_GUI_LIB
 QRect getScreenResolution();
 #endif
+
+// Builds a command line in one buffer, instead of a normalizeAndQuote / insertQuotes temporary for each argument
+// e.g. CommandLineBuilder().addArgument("-export").addPath(inputFile).addPath(outputFile).toArguments()
+class CommandLineBuilder{
+public:
+    explicit CommandLineBuilder(int reserveChars = 256);
+
+    // quoted only when it has spaces, quotes or other chars a command line could interpret
+    CommandLineBuilder &addArgument(QStringView argument, bool alwaysQuote = false);
+    // normalized (backslashes to slashes) and always quoted
+    CommandLineBuilder &addPath(QStringView path);
+
+    int size() const;
+    void clear();
+
+    // the arguments joined by spaces, allocated once with its final size, for QProcess::start(command)
+    // (quotes follow QProcess::splitCommand, not a shell: """ is a literal quote and backslashes aren't escapes)
+    // QProcess drops empty arguments from a command, use toArguments when there can be any
+    QString toString() const;
+    // the arguments unquoted, for QProcess::start(program, arguments)
+    QStringList toArguments() const;
+
+private:
+    struct Argument{
+        int offset;
+        int size;
+        bool quoted;
+    };
+
+    void appendArgument(QStringView argument, bool isPath, bool quote);
+
+    QString buffer; // all the arguments, back to back
+    QVector<Argument> arguments;
+    int joinedSize = 0;
+};
 }
 
 #ifdef QT_GUI_LIB
@@ -132,6 +616,42 @@ void showInfo(QStatusBar * const statusBar, const QString &message);
 void showError(QStatusBar * const statusBar, const QString &message);
 void showSuccess(QStatusBar * const  statusBar,const QString &message);
 
+// Status messages that can be posted from any thread, at any rate
+// Only the latest message of each severity is kept, and the status bar is updated at most maxUpdatesPerSecond times
+// (the most severe pending message wins). Create it in the GUI thread, it is deleted with the status bar.
+class StatusBarChannel : public QObject{
+    Q_OBJECT
+public:
+    enum class Severity{
+        Info,
+        Success,
+        Error
+    };
+
+    explicit StatusBarChannel(QStatusBar *statusBar, int maxUpdatesPerSecond = 30);
+
+    void post(Severity severity, const QString &message);
+    void postInfo(const QString &message);
+    void postSuccess(const QString &message);
+    void postError(const QString &message);
+
+private slots:
+    void flush();
+
+private:
+    void scheduleFlush();
+
+    QStatusBar *statusBar;
+    const int flushInterval;
+    QTimer *flushTimer;
+    QElapsedTimer sinceLastFlush;
+
+    QMutex pendingMutex;
+    QString pendingMessages[3];
+    bool hasPendingMessage[3];
+    bool isFlushScheduled = false;
+};
+
 }
 #endif
 
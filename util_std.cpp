@@ -0,0 +1,1302 @@
+/**
+ * Copyright (C) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * This library is distributed under the MIT License. See notice at the end
+ * of this file.
+ *
+ */
+
+#include "util_std.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+
+#ifndef FICLONE // older kernel headers
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
+namespace Util{
+
+namespace Std{
+
+namespace {
+
+// Thread safe, unlike strerror
+std::string errorString(const int errorNumber){
+    return std::error_code(errorNumber, std::generic_category()).message();
+}
+
+int resolveThreadCount(const int maxThreads){
+    return maxThreads > 0 ? maxThreads : std::max(1, int(std::thread::hardware_concurrency()));
+}
+
+// Hands (source, destination) pairs from the folder walk to the copy workers
+// push blocks while it is full, so memory stays bounded however many files the tree has
+class CopyQueue{
+public:
+    explicit CopyQueue(const size_t capacity) : capacity(capacity){
+    }
+
+    void push(std::pair<std::string, std::string> &&item){
+        std::unique_lock<std::mutex> locker(mutex);
+        notFull.wait(locker, [this](){ return items.size() < capacity; });
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+    }
+
+    // false once closed and empty
+    bool pop(std::pair<std::string, std::string> &item){
+        std::unique_lock<std::mutex> locker(mutex);
+        notEmpty.wait(locker, [this](){ return !items.empty() || isClosed; });
+
+        if(items.empty()){
+            return false;
+        }
+
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close(){
+        std::lock_guard<std::mutex> locker(mutex);
+        isClosed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    const size_t capacity;
+    std::deque<std::pair<std::string, std::string>> items;
+    bool isClosed = false;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+};
+
+// Code point starting at data[i] (i is moved past it), invalid bytes are returned as 0xDC00 + byte so they still count as one char
+std::uint32_t decodeUtf8(const std::string_view data, size_t &i){
+    const unsigned char first = static_cast<unsigned char>(data[i]);
+
+    int length = 0;
+    std::uint32_t codePoint = 0;
+
+    if(first < 0x80){
+        i++;
+        return first;
+    }
+    else if((first & 0xE0) == 0xC0){
+        length = 2;
+        codePoint = first & 0x1F;
+    }
+    else if((first & 0xF0) == 0xE0){
+        length = 3;
+        codePoint = first & 0x0F;
+    }
+    else if((first & 0xF8) == 0xF0){
+        length = 4;
+        codePoint = first & 0x07;
+    }
+
+    if(length == 0 || i + length > data.size()){
+        i++;
+        return 0xDC00 + first;
+    }
+
+    for(int j = 1; j < length; j++){
+        const unsigned char currByte = static_cast<unsigned char>(data[i + j]);
+        if((currByte & 0xC0) != 0x80){
+            i++;
+            return 0xDC00 + first;
+        }
+        codePoint = (codePoint << 6) | (currByte & 0x3F);
+    }
+
+    i += length;
+    return codePoint;
+}
+
+// Same set as QChar::isSpace
+bool isSpace(const std::uint32_t codePoint){
+    if(codePoint < 0x80){
+        return codePoint == ' ' || (codePoint >= 0x09 && codePoint <= 0x0D);
+    }
+
+    return codePoint == 0x85 || codePoint == 0xA0 || codePoint == 0x1680 || (codePoint >= 0x2000 && codePoint <= 0x200A) ||
+            codePoint == 0x2028 || codePoint == 0x2029 || codePoint == 0x202F || codePoint == 0x205F || codePoint == 0x3000;
+}
+
+}
+
+namespace FileSystem {
+
+std::string normalizePath(std::string_view path){
+    std::string result(path);
+    normalizePathInPlace(result);
+    return result;
+}
+
+void normalizePathInPlace(std::string &path){
+    std::replace(path.begin(), path.end(), '\\', '/');
+}
+
+namespace {
+
+// path from the index "from" without the quotes
+std::string nameWithoutQuotes(std::string_view path, const size_t from){
+    std::string result;
+    result.reserve(path.size() - from);
+
+    for(size_t i = from; i < path.size(); i++){
+        if(path[i] != '"'){
+            result += path[i];
+        }
+    }
+
+    return result;
+}
+
+}
+
+std::string cutName(std::string_view path){
+    const size_t lastSlash = path.rfind('/');
+    return nameWithoutQuotes(path, lastSlash == std::string_view::npos ? 0 : lastSlash);
+}
+
+std::string cutNameWithoutBackSlash(std::string_view path){
+    // only the last slash is left after cutName
+    const size_t lastSlash = path.rfind('/');
+    return nameWithoutQuotes(path, lastSlash == std::string_view::npos ? 0 : lastSlash + 1);
+}
+
+std::string_view cutNameView(std::string_view path){
+    const size_t lastSlash = path.rfind('/');
+    std::string_view name = lastSlash == std::string_view::npos ? path : path.substr(lastSlash + 1);
+
+    while(!name.empty() && name.front() == '"'){
+        name.remove_prefix(1);
+    }
+    while(!name.empty() && name.back() == '"'){
+        name.remove_suffix(1);
+    }
+
+    return name;
+}
+
+std::string normalizeAndQuote(std::string_view path){
+    return String::insertQuotes(normalizePath(path));
+}
+
+namespace {
+
+CopyStrategy copyFileContents(const std::string &sourcePath, const std::string &destinationPath, const CloneMode cloneMode, std::int64_t &bytesCopied, std::string &errorMessage){
+    const int sourceFd = ::open(sourcePath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if(sourceFd == -1){
+        errorMessage = errorString(errno);
+        return CopyStrategy::Failed;
+    }
+
+    struct stat sourceStat;
+
+    if(::fstat(sourceFd, &sourceStat) != 0){
+        errorMessage = errorString(errno);
+        ::close(sourceFd);
+        return CopyStrategy::Failed;
+    }
+
+    if(cloneMode == CloneMode::ReflinkOrHardLink){
+        // also fails if the destination exists, so nothing created by someone else is ever replaced
+        // (link() would hardlink a symlinked source itself instead of the file copied otherwise)
+        if(::linkat(AT_FDCWD, sourcePath.c_str(), AT_FDCWD, destinationPath.c_str(), AT_SYMLINK_FOLLOW) == 0){
+            ::close(sourceFd);
+            bytesCopied += sourceStat.st_size;
+            return CopyStrategy::HardLink;
+        }
+
+        if(errno == EEXIST){
+            errorMessage = errorString(errno);
+            ::close(sourceFd);
+            return CopyStrategy::Failed;
+        }
+        // e.g. other filesystem, clone or copy it
+    }
+
+    // O_EXCL, existing files are never overwritten
+    const int destinationFd = ::open(destinationPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, sourceStat.st_mode & 0777);
+
+    if(destinationFd == -1){
+        errorMessage = errorString(errno);
+        ::close(sourceFd);
+        return CopyStrategy::Failed;
+    }
+
+    CopyStrategy strategy = CopyStrategy::FullCopy;
+    int errorNumber = 0; // of the first call that failed
+    std::int64_t fileBytesCopied = 0;
+
+#ifdef __linux__
+    if(cloneMode != CloneMode::Disabled && ::ioctl(destinationFd, FICLONE, sourceFd) == 0){
+        strategy = CopyStrategy::Reflink;
+        fileBytesCopied = sourceStat.st_size;
+    }
+#endif
+
+    bool isCopied = strategy == CopyStrategy::Reflink;
+
+#ifdef __linux__
+    // in kernel copies first, copy_file_range (can also reflink on its own) then sendfile
+    for(bool useCopyFileRange : {true, false}){
+        if(isCopied){
+            break;
+        }
+
+        while(true){
+            const ssize_t currBytes = useCopyFileRange ?
+                        ::copy_file_range(sourceFd, nullptr, destinationFd, nullptr, 1 << 30, 0) :
+                        ::sendfile(destinationFd, sourceFd, nullptr, 1 << 30);
+
+            if(currBytes > 0){
+                fileBytesCopied += currBytes;
+                continue;
+            }
+
+            isCopied = currBytes == 0;
+            break;
+        }
+
+        if(fileBytesCopied > 0){
+            break; // done, or failed halfway (the read / write loop below reports it)
+        }
+    }
+#endif
+
+    if(!isCopied){
+        // plain read / write, from where the in kernel copy stopped
+        std::vector<char> buffer(1 << 20);
+
+        if(::lseek(sourceFd, fileBytesCopied, SEEK_SET) == -1 || ::lseek(destinationFd, fileBytesCopied, SEEK_SET) == -1){
+            errorNumber = errno;
+        }
+
+        while(errorNumber == 0){
+            const ssize_t bytesRead = ::read(sourceFd, buffer.data(), buffer.size());
+
+            if(bytesRead == 0){
+                isCopied = true;
+                break;
+            }
+            if(bytesRead < 0){
+                if(errno != EINTR){
+                    errorNumber = errno;
+                }
+                continue;
+            }
+
+            for(ssize_t written = 0; written < bytesRead && errorNumber == 0;){
+                const ssize_t bytesWritten = ::write(destinationFd, buffer.data() + written, size_t(bytesRead - written));
+                if(bytesWritten < 0){
+                    if(errno != EINTR){
+                        errorNumber = errno;
+                    }
+                    continue;
+                }
+                written += bytesWritten;
+            }
+
+            fileBytesCopied += bytesRead;
+        }
+    }
+
+    // same permissions as the source, regardless of the umask
+    if(isCopied && ::fchmod(destinationFd, sourceStat.st_mode & 07777) != 0){
+        errorNumber = errno;
+        isCopied = false;
+    }
+
+    if(::close(destinationFd) != 0 && isCopied){
+        errorNumber = errno;
+        isCopied = false;
+    }
+
+    ::close(sourceFd);
+
+    if(!isCopied){
+        errorMessage = errorString(errorNumber);
+        ::unlink(destinationPath.c_str());
+        return CopyStrategy::Failed;
+    }
+
+    bytesCopied += fileBytesCopied;
+
+    return strategy;
+}
+
+}
+
+CopyStrategy copyFile(const std::string &sourcePath, const std::string &destinationPath, const CloneMode cloneMode, std::string *errorString){
+    std::int64_t bytesCopied = 0;
+    std::string currErrorString;
+
+    const CopyStrategy strategy = copyFileContents(sourcePath, destinationPath, cloneMode, bytesCopied, currErrorString);
+
+    if(errorString != nullptr){
+        *errorString = currErrorString;
+    }
+
+    return strategy;
+}
+
+bool copyDir(const std::string &fromPath, const std::string &toPath, const bool isRecursive){
+    CopyDirOptions options;
+    options.isRecursive = isRecursive;
+
+    return copyDir(fromPath, toPath, options).success();
+}
+
+// Walks the source tree first (creating the destination folders as it goes), then the files are copied by the worker threads
+CopyDirResult copyDir(const std::string &fromPath, const std::string &toPath, const CopyDirOptions &options){
+    namespace fs = std::filesystem;
+
+    CopyDirResult result;
+    std::error_code error;
+
+    fs::path fromDir = fs::absolute(fs::path(fromPath), error).lexically_normal();
+    if(!fromDir.has_filename()){
+        fromDir = fromDir.parent_path(); // trailing slash
+    }
+
+    const std::string rootDestination = toPath + "/" + fromDir.filename().string();
+
+    if(::mkdir(rootDestination.c_str(), 0777) != 0){ // create the folder in the destination
+        result.errors.push_back(CopyFileError{fromDir.string(), rootDestination, "Couldn't create the destination folder."});
+        return result;
+    }
+
+    // the calling thread walks the tree while the workers copy what it found so far
+    std::mutex resultMutex;
+    CopyQueue files(4096);
+    std::vector<std::thread> workers;
+
+    for(int i = resolveThreadCount(options.maxThreads); i > 0; i--){
+        workers.emplace_back([&](){
+            std::pair<std::string, std::string> currFile;
+
+            while(files.pop(currFile)){
+                std::int64_t bytesCopied = 0;
+                std::string errorMessage;
+
+                const CopyStrategy strategy = copyFileContents(currFile.first, currFile.second, options.cloneMode, bytesCopied, errorMessage);
+
+                std::lock_guard<std::mutex> locker(resultMutex);
+
+                if(strategy != CopyStrategy::Failed){
+                    result.filesCopied++;
+                    result.bytesCopied += bytesCopied;
+                }
+                else{
+                    result.errors.push_back(CopyFileError{currFile.first, currFile.second, errorMessage});
+                }
+            }
+        });
+    }
+
+    // pairs of (source, destination)
+    std::vector<std::pair<std::string, std::string>> pendingFolders;
+    pendingFolders.emplace_back(fromDir.string(), rootDestination);
+
+    while(!pendingFolders.empty()){
+        const std::pair<std::string, std::string> currFolder = pendingFolders.back();
+        pendingFolders.pop_back();
+
+        for(fs::directory_iterator it(currFolder.first, error), end; !error && it != end; it.increment(error)){
+            const std::string fileName = it->path().filename().string();
+
+            // hidden entries are skipped, like QDir does without QDir::Hidden
+            if(fileName.empty() || fileName[0] == '.'){
+                continue;
+            }
+
+            std::string sourcePath = currFolder.first + "/" + fileName;
+            std::string destinationPath = currFolder.second + "/" + fileName;
+            std::error_code statusError;
+            const fs::file_status status = it->status(statusError); // follows symlinks, like QFileInfo
+
+            if(fs::is_regular_file(status)){
+                files.push(std::make_pair(std::move(sourcePath), std::move(destinationPath)));
+            }
+            else if(options.isRecursive && fs::is_directory(status)){
+                if(::mkdir(destinationPath.c_str(), 0777) != 0){
+                    std::lock_guard<std::mutex> locker(resultMutex);
+                    result.errors.push_back(CopyFileError{sourcePath, destinationPath, "Couldn't create the destination folder."});
+                    continue;
+                }
+
+                pendingFolders.emplace_back(std::move(sourcePath), std::move(destinationPath));
+            }
+        }
+
+        if(error){
+            std::lock_guard<std::mutex> locker(resultMutex);
+            result.errors.push_back(CopyFileError{currFolder.first, currFolder.second, error.message()});
+            error.clear();
+        }
+    }
+
+    files.close();
+
+    for(std::thread &currWorker : workers){
+        currWorker.join();
+    }
+
+    return result;
+}
+
+namespace {
+
+// Removes name (relative to parentFd) and everything under it, symlinks are removed, never followed
+void removeTree(const int parentFd, const std::string &name, const std::string &path, RmDirResult &result){
+    const int dirFd = ::openat(parentFd, name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+    if(dirFd == -1){
+        result.errors.push_back(RmDirError{path, errorString(errno)});
+        return;
+    }
+
+    DIR *dir = ::fdopendir(dirFd);
+
+    if(dir == nullptr){
+        result.errors.push_back(RmDirError{path, errorString(errno)});
+        ::close(dirFd);
+        return;
+    }
+
+    const size_t errorsBefore = result.errors.size();
+
+    while(struct dirent *entry = ::readdir(dir)){
+        const char *entryName = entry->d_name;
+
+        if(std::strcmp(entryName, ".") == 0 || std::strcmp(entryName, "..") == 0){
+            continue;
+        }
+
+        bool isDir = entry->d_type == DT_DIR;
+
+        if(entry->d_type == DT_UNKNOWN){ // some filesystems don't fill d_type
+            struct stat entryStat;
+            isDir = ::fstatat(dirFd, entryName, &entryStat, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(entryStat.st_mode);
+        }
+
+        if(isDir){
+            removeTree(dirFd, entryName, path + "/" + entryName, result);
+        }
+        else if(::unlinkat(dirFd, entryName, 0) == 0){
+            result.entriesRemoved++;
+        }
+        else{
+            result.errors.push_back(RmDirError{path + "/" + entryName, errorString(errno)});
+        }
+    }
+
+    ::closedir(dir); // closes dirFd too
+
+    if(result.errors.size() != errorsBefore){
+        return; // not empty, no point trying
+    }
+
+    if(::unlinkat(parentFd, name.c_str(), AT_REMOVEDIR) == 0){
+        result.entriesRemoved++;
+    }
+    else{
+        result.errors.push_back(RmDirError{path, errorString(errno)});
+    }
+}
+
+}
+
+bool rmDir(const std::string &dirPath, RmDirResult *result){
+    namespace fs = std::filesystem;
+
+    RmDirResult currResult;
+    std::error_code error;
+
+    fs::path dir = fs::absolute(fs::path(dirPath), error).lexically_normal();
+    if(!dir.has_filename()){
+        dir = dir.parent_path(); // trailing slash
+    }
+
+    struct stat dirStat;
+
+    if(::lstat(dir.c_str(), &dirStat) == 0){
+        const std::string parentPath = dir.parent_path().string();
+        const int parentFd = ::open(parentPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        if(parentFd == -1){
+            currResult.errors.push_back(RmDirError{parentPath, errorString(errno)});
+        }
+        else{
+            if(S_ISLNK(dirStat.st_mode)){
+                // only the link is removed, never what it points to (like the Qt version)
+                if(::unlinkat(parentFd, dir.filename().c_str(), 0) == 0){
+                    currResult.entriesRemoved++;
+                }
+                else{
+                    currResult.errors.push_back(RmDirError{dir.string(), errorString(errno)});
+                }
+            }
+            else{
+                removeTree(parentFd, dir.filename().string(), dir.string(), currResult);
+            }
+            ::close(parentFd);
+        }
+    }
+
+    const bool isRemoved = currResult.success();
+
+    if(result != nullptr){
+        *result = std::move(currResult);
+    }
+
+    return isRemoved;
+}
+
+namespace {
+
+// Applies the wildcard rules, e.g.:
+// *.xml -> *.xml
+// /myXmls/*.xml -> */myXmls/*.xml
+// myXmls\\file?.xml -> */myXmls/file?.xml
+std::string formatWildcard(std::string_view wildcard){
+    std::string formattedWildcard = normalizePath(wildcard);
+
+    // if it doesn't start with any wildcard or a subdirectory slash, add a slash to beginning (so the file/folder matches at least the root folder)
+    if(formattedWildcard.empty() || (formattedWildcard[0] != '/' && formattedWildcard[0] != '*' && formattedWildcard[0] != '?')){
+        formattedWildcard.insert(0, 1, '/');
+    }
+
+    // if it is a subdirectory add * to match
+    if(formattedWildcard[0] == '/'){
+        formattedWildcard.insert(0, 1, '*');
+    }
+
+    return formattedWildcard;
+}
+
+}
+
+// Same automaton as Util::FileSystem::WildcardMatcher, over code points decoded from UTF-8
+WildcardMatcher::WildcardMatcher(){
+    compile(std::vector<std::string>());
+}
+
+WildcardMatcher::WildcardMatcher(std::string_view wildcard){
+    compile(std::vector<std::string>{std::string(wildcard)});
+}
+
+WildcardMatcher::WildcardMatcher(const std::vector<std::string> &wildcards){
+    compile(wildcards);
+}
+
+void WildcardMatcher::compile(const std::vector<std::string> &wildcards){
+
+    // tokens for * and ? (code points never go that high)
+    const std::uint32_t starToken = 0xFFFFFFFF;
+    const std::uint32_t anyToken = 0xFFFFFFFE;
+
+    std::vector<std::vector<std::uint32_t>> tokens;
+
+    for(const std::string &currWildcard : wildcards){
+        std::vector<std::uint32_t> currTokens;
+
+        if(!String::fullTrim(currWildcard).empty()){
+            const std::string formattedWildcard = formatWildcard(currWildcard);
+
+            for(size_t i = 0; i < formattedWildcard.size();){
+                const std::uint32_t currCodePoint = decodeUtf8(formattedWildcard, i);
+
+                if(currCodePoint == '*'){
+                    if(currTokens.empty() || currTokens.back() != starToken){ // ** is the same as *
+                        currTokens.push_back(starToken);
+                    }
+                }
+                else{
+                    currTokens.push_back(currCodePoint == '?' ? anyToken : currCodePoint);
+                }
+            }
+        }
+
+        tokens.push_back(std::move(currTokens));
+    }
+
+    // one position per token plus the accepting one, for each wildcard
+    int totalPositions = 0;
+
+    for(const std::vector<std::uint32_t> &currTokens : tokens){
+        totalPositions += int(currTokens.size()) + 1;
+    }
+
+    stateWords = (totalPositions + 63) / 64;
+    starMask.assign(stateWords, 0);
+    initialStates.assign(stateWords, 0);
+    acceptStates.assign(stateWords, 0);
+    acceptPositions.clear();
+
+    // row 0: chars not used in any wildcard (only ? moves on), row 1: line feed (? doesn't match it)
+    rows.assign(2 * stateWords, 0);
+    std::fill(asciiRows, asciiRows + 128, 0);
+    asciiRows['\n'] = 1;
+    otherRows.clear();
+
+    auto setBit = [](std::vector<std::uint64_t> &bits, const int offset, const int position){
+        bits[offset + position / 64] |= std::uint64_t(1) << (position % 64);
+    };
+
+    int currPosition = 0;
+
+    for(const std::vector<std::uint32_t> &currTokens : tokens){
+        if(currTokens.empty()){ // empty wildcards never match
+            acceptPositions.push_back(-1);
+            currPosition++;
+            continue;
+        }
+
+        setBit(initialStates, 0, currPosition);
+
+        for(const std::uint32_t currToken : currTokens){
+            if(currToken == starToken){
+                setBit(starMask, 0, currPosition);
+            }
+            else if(currToken == anyToken){
+                setBit(rows, 0, currPosition);
+            }
+            currPosition++;
+        }
+
+        setBit(acceptStates, 0, currPosition);
+        acceptPositions.push_back(currPosition);
+        currPosition++;
+    }
+
+    // a row for each literal char, which also includes the ? positions (row 0)
+    auto rowFor = [this](const std::uint32_t codePoint) -> int{
+        int *existingRow = codePoint < 128 ? &asciiRows[codePoint] : nullptr;
+        int rowIndex = 0;
+
+        if(existingRow != nullptr){
+            rowIndex = *existingRow;
+        }
+        else{
+            const auto otherRow = otherRows.find(codePoint);
+            rowIndex = otherRow != otherRows.end() ? otherRow->second : 0;
+        }
+
+        if(rowIndex == 0){
+            rowIndex = int(rows.size()) / stateWords;
+            rows.resize(rows.size() + stateWords);
+            std::copy(rows.begin(), rows.begin() + stateWords, rows.begin() + rowIndex * stateWords);
+
+            if(existingRow != nullptr){
+                *existingRow = rowIndex;
+            }
+            else{
+                otherRows[codePoint] = rowIndex;
+            }
+        }
+
+        return rowIndex;
+    };
+
+    currPosition = 0;
+
+    for(const std::vector<std::uint32_t> &currTokens : tokens){
+        for(const std::uint32_t currToken : currTokens){
+            if(currToken != starToken && currToken != anyToken){
+                setBit(rows, rowFor(currToken) * stateWords, currPosition);
+            }
+            currPosition++;
+        }
+        currPosition++;
+    }
+
+    // positions right after a * are also active when the * is (it may match nothing)
+    for(int i = 0; i < stateWords; i++){
+        initialStates[i] |= (initialStates[i] & starMask[i]) << 1 | (i > 0 ? (initialStates[i - 1] & starMask[i - 1]) >> 63 : 0);
+    }
+}
+
+bool WildcardMatcher::isEmpty() const{
+    for(const int currAcceptPosition : acceptPositions){
+        if(currAcceptPosition != -1){
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WildcardMatcher::matches(std::string_view filePath) const{
+    return matchIndex(filePath) != -1;
+}
+
+int WildcardMatcher::matchIndex(std::string_view filePath) const{
+    if(isEmpty()){
+        return -1;
+    }
+
+    std::vector<std::uint64_t> states(initialStates);
+    std::vector<std::uint64_t> acceptedBeforeLineFeed(stateWords, 0);
+
+    for(size_t i = 0; i < filePath.size();){
+        const std::uint32_t codePoint = decodeUtf8(filePath, i);
+        const bool isLast = i == filePath.size();
+        const bool isLineFeed = codePoint == '\n';
+
+        if(isLineFeed && isLast){ // '$' also matches before a final line feed
+            for(int w = 0; w < stateWords; w++){
+                acceptedBeforeLineFeed[w] = states[w] & acceptStates[w];
+            }
+        }
+
+        int rowIndex = 0;
+
+        if(codePoint < 128){
+            rowIndex = asciiRows[codePoint];
+        }
+        else{
+            const auto otherRow = otherRows.find(codePoint);
+            rowIndex = otherRow != otherRows.end() ? otherRow->second : 0;
+        }
+
+        const std::uint64_t *row = &rows[size_t(rowIndex) * stateWords];
+        std::uint64_t carry = 0;
+        std::uint64_t starCarry = 0;
+        std::uint64_t anyActive = 0;
+
+        for(int w = 0; w < stateWords; w++){
+            // move on from positions that accept this char, and stay on the * ones
+            const std::uint64_t advancing = states[w] & row[w];
+            std::uint64_t next = (advancing << 1) | carry | (isLineFeed ? 0 : states[w] & starMask[w]);
+            carry = advancing >> 63;
+
+            // positions after an active * are active too
+            const std::uint64_t activeStars = next & starMask[w];
+            next |= (activeStars << 1) | starCarry;
+            starCarry = activeStars >> 63;
+
+            states[w] = next;
+            anyActive |= next;
+        }
+
+        if(anyActive == 0 && !isLast){
+            return -1;
+        }
+    }
+
+    for(int currWildcard = 0; currWildcard < int(acceptPositions.size()); currWildcard++){
+        const int currAcceptPosition = acceptPositions[currWildcard];
+
+        if(currAcceptPosition == -1){
+            continue;
+        }
+
+        const int word = currAcceptPosition / 64;
+        const std::uint64_t bit = std::uint64_t(1) << (currAcceptPosition % 64);
+
+        if(((states[word] | acceptedBeforeLineFeed[word]) & bit) != 0){
+            return currWildcard;
+        }
+    }
+
+    return -1;
+}
+
+std::vector<std::string> filterFilesByWildcard(const std::vector<std::string> &filePaths, std::string_view wildcard){
+    return filterFilesByWildcard(filePaths, WildcardMatcher(wildcard));
+}
+
+// Files matching any of the wildcards
+std::vector<std::string> filterFilesByWildcard(const std::vector<std::string> &filePaths, const std::vector<std::string> &wildcards){
+    return filterFilesByWildcard(filePaths, WildcardMatcher(wildcards));
+}
+
+std::vector<std::string> filterFilesByWildcard(const std::vector<std::string> &filePaths, const WildcardMatcher &matcher){
+    std::vector<std::string> resultFiles;
+
+    if(matcher.isEmpty()){
+        return resultFiles;
+    }
+
+    for(const std::string &currentFile : filePaths){
+        if(matcher.matches(currentFile)){
+            resultFiles.push_back(currentFile);
+        }
+    }
+
+    return resultFiles;
+}
+
+namespace {
+
+inline std::uint32_t rotateLeft(const std::uint32_t value, const int bits){
+    return (value << bits) | (value >> (32 - bits));
+}
+
+inline std::uint32_t rotateRight(const std::uint32_t value, const int bits){
+    return (value >> bits) | (value << (32 - bits));
+}
+
+// Block hash with the Merkle-Damgard padding shared by MD5, SHA-1 and SHA-256 (64 byte blocks, 64 bit length)
+class Hasher{
+public:
+    explicit Hasher(const HashAlgorithm algorithm) : algorithm(algorithm){
+        switch(algorithm){
+        case HashAlgorithm::Md5:
+            state = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+            break;
+        case HashAlgorithm::Sha1:
+            state = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+            break;
+        case HashAlgorithm::Sha256:
+            state = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+            break;
+        }
+    }
+
+    void addData(const unsigned char *data, size_t size){
+        totalBytes += size;
+
+        if(bufferSize > 0){
+            const size_t toCopy = std::min(size, sizeof(buffer) - bufferSize);
+            std::memcpy(buffer + bufferSize, data, toCopy);
+            bufferSize += toCopy;
+            data += toCopy;
+            size -= toCopy;
+
+            if(bufferSize < sizeof(buffer)){
+                return;
+            }
+
+            processBlock(buffer);
+            bufferSize = 0;
+        }
+
+        for(; size >= 64; data += 64, size -= 64){
+            processBlock(data);
+        }
+
+        std::memcpy(buffer, data, size);
+        bufferSize = size;
+    }
+
+    std::string hexResult(){
+        const std::uint64_t totalBits = totalBytes * 8;
+
+        unsigned char padding[72] = {0x80};
+        const size_t paddingSize = (bufferSize < 56 ? 56 : 120) - bufferSize;
+        unsigned char lengthBytes[8];
+
+        for(int i = 0; i < 8; i++){
+            // MD5 is little endian, the SHAs big endian
+            const int shift = algorithm == HashAlgorithm::Md5 ? i * 8 : (7 - i) * 8;
+            lengthBytes[i] = static_cast<unsigned char>(totalBits >> shift);
+        }
+
+        addData(padding, paddingSize);
+        addData(lengthBytes, 8);
+
+        static const char hexDigits[] = "0123456789abcdef";
+        std::string result;
+        result.reserve(state.size() * 8);
+
+        for(const std::uint32_t currWord : state){
+            for(int i = 0; i < 4; i++){
+                const int shift = algorithm == HashAlgorithm::Md5 ? i * 8 : (3 - i) * 8;
+                const unsigned char currByte = static_cast<unsigned char>(currWord >> shift);
+                result += hexDigits[currByte >> 4];
+                result += hexDigits[currByte & 0x0F];
+            }
+        }
+
+        return result;
+    }
+
+private:
+    void processBlock(const unsigned char *block){
+        switch(algorithm){
+        case HashAlgorithm::Md5:
+            processMd5(block);
+            break;
+        case HashAlgorithm::Sha1:
+            processSha1(block);
+            break;
+        case HashAlgorithm::Sha256:
+            processSha256(block);
+            break;
+        }
+    }
+
+    void processMd5(const unsigned char *block){
+        static const std::uint32_t k[64] = {
+            0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+            0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+            0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+            0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+            0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+            0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+            0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+            0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+        };
+        static const int shifts[64] = {
+            7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+            5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+            4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+            6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+        };
+
+        std::uint32_t words[16];
+        for(int i = 0; i < 16; i++){
+            words[i] = std::uint32_t(block[i * 4]) | std::uint32_t(block[i * 4 + 1]) << 8 | std::uint32_t(block[i * 4 + 2]) << 16 | std::uint32_t(block[i * 4 + 3]) << 24;
+        }
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+
+        for(int i = 0; i < 64; i++){
+            std::uint32_t f;
+            int g;
+
+            if(i < 16){
+                f = (b & c) | (~b & d);
+                g = i;
+            }
+            else if(i < 32){
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) % 16;
+            }
+            else if(i < 48){
+                f = b ^ c ^ d;
+                g = (3 * i + 5) % 16;
+            }
+            else{
+                f = c ^ (b | ~d);
+                g = (7 * i) % 16;
+            }
+
+            const std::uint32_t temp = d;
+            d = c;
+            c = b;
+            b = b + rotateLeft(a + f + k[i] + words[g], shifts[i]);
+            a = temp;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+    }
+
+    void processSha1(const unsigned char *block){
+        std::uint32_t words[80];
+        for(int i = 0; i < 16; i++){
+            words[i] = std::uint32_t(block[i * 4]) << 24 | std::uint32_t(block[i * 4 + 1]) << 16 | std::uint32_t(block[i * 4 + 2]) << 8 | std::uint32_t(block[i * 4 + 3]);
+        }
+        for(int i = 16; i < 80; i++){
+            words[i] = rotateLeft(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+        }
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+        for(int i = 0; i < 80; i++){
+            std::uint32_t f;
+            std::uint32_t k;
+
+            if(i < 20){
+                f = (b & c) | (~b & d);
+                k = 0x5a827999;
+            }
+            else if(i < 40){
+                f = b ^ c ^ d;
+                k = 0x6ed9eba1;
+            }
+            else if(i < 60){
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8f1bbcdc;
+            }
+            else{
+                f = b ^ c ^ d;
+                k = 0xca62c1d6;
+            }
+
+            const std::uint32_t temp = rotateLeft(a, 5) + f + e + k + words[i];
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+
+    void processSha256(const unsigned char *block){
+        static const std::uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        std::uint32_t words[64];
+        for(int i = 0; i < 16; i++){
+            words[i] = std::uint32_t(block[i * 4]) << 24 | std::uint32_t(block[i * 4 + 1]) << 16 | std::uint32_t(block[i * 4 + 2]) << 8 | std::uint32_t(block[i * 4 + 3]);
+        }
+        for(int i = 16; i < 64; i++){
+            const std::uint32_t s0 = rotateRight(words[i - 15], 7) ^ rotateRight(words[i - 15], 18) ^ (words[i - 15] >> 3);
+            const std::uint32_t s1 = rotateRight(words[i - 2], 17) ^ rotateRight(words[i - 2], 19) ^ (words[i - 2] >> 10);
+            words[i] = words[i - 16] + s0 + words[i - 7] + s1;
+        }
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for(int i = 0; i < 64; i++){
+            const std::uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            const std::uint32_t choice = (e & f) ^ (~e & g);
+            const std::uint32_t temp1 = h + s1 + choice + k[i] + words[i];
+            const std::uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            const std::uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            const std::uint32_t temp2 = s0 + majority;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    const HashAlgorithm algorithm;
+    std::vector<std::uint32_t> state;
+    unsigned char buffer[64];
+    size_t bufferSize = 0;
+    std::uint64_t totalBytes = 0;
+};
+
+}
+
+std::string fileHash(const std::string &fileName, HashAlgorithm hashAlgorithm){
+    const int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if(fd == -1){
+        return std::string();
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    Hasher hasher(hashAlgorithm);
+    std::vector<unsigned char> buffer(1 << 20);
+    bool isRead = true;
+
+    while(true){
+        const ssize_t bytesRead = ::read(fd, buffer.data(), buffer.size());
+
+        if(bytesRead == 0){
+            break;
+        }
+        if(bytesRead < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            isRead = false;
+            break;
+        }
+
+        hasher.addData(buffer.data(), size_t(bytesRead));
+    }
+
+    ::close(fd);
+
+    return isRead ? hasher.hexResult() : std::string();
+}
+
+std::string dataHash(std::string_view data, HashAlgorithm hashAlgorithm){
+    Hasher hasher(hashAlgorithm);
+    hasher.addData(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    return hasher.hexResult();
+}
+
+}
+
+namespace String {
+
+std::string insertApostrophes(std::string_view currString){
+    std::string result;
+    result.reserve(currString.size() + 2);
+    result += '\'';
+    result += currString;
+    result += '\'';
+    return result;
+}
+
+std::string insertQuotes(std::string_view currString){
+    std::string result;
+    result.reserve(currString.size() + 2);
+    result += '"';
+    result += currString;
+    result += '"';
+    return result;
+}
+
+std::string fullTrim(std::string_view str){
+    std::string result(str);
+    fullTrimInPlace(result);
+    return result;
+}
+
+void fullTrimInPlace(std::string &str){
+    size_t resultSize = 0;
+
+    for(size_t i = 0; i < str.size();){
+        const unsigned char currByte = static_cast<unsigned char>(str[i]);
+
+        // ASCII fast path
+        if(currByte < 0x80){
+            if(!isSpace(currByte)){
+                str[resultSize++] = str[i];
+            }
+            i++;
+            continue;
+        }
+
+        const size_t start = i;
+        const std::uint32_t codePoint = decodeUtf8(str, i);
+
+        if(!isSpace(codePoint)){
+            for(size_t j = start; j < i; j++){
+                str[resultSize++] = str[j];
+            }
+        }
+    }
+
+    str.resize(resultSize);
+}
+
+std::vector<std::string_view> splitView(std::string_view text, std::string_view separator){
+    std::vector<std::string_view> result;
+
+    if(separator.empty()){
+        result.push_back(text);
+        return result;
+    }
+
+    // count first so the result is allocated only once
+    size_t tokenCount = 1;
+    for(size_t currIdx = text.find(separator); currIdx != std::string_view::npos; currIdx = text.find(separator, currIdx + separator.size())){
+        tokenCount++;
+    }
+
+    result.reserve(tokenCount);
+
+    size_t currIdx = 0;
+
+    while(true){
+        const size_t nextIdx = text.find(separator, currIdx);
+
+        if(nextIdx == std::string_view::npos){
+            result.push_back(text.substr(currIdx));
+            break;
+        }
+
+        result.push_back(text.substr(currIdx, nextIdx - currIdx));
+        currIdx = nextIdx + separator.size();
+    }
+
+    return result;
+}
+
+std::vector<std::string> substring(std::string_view myString, std::string_view separator){
+    const std::vector<std::string_view> tokens = splitView(myString, separator);
+    return std::vector<std::string>(tokens.begin(), tokens.end());
+}
+
+std::string normalizeDecimalSeparator(std::string_view value){
+    std::string result(value);
+    std::replace(result.begin(), result.end(), ',', '.');
+    return result;
+}
+
+// no problem here with "temporary" cstr
+// https://stackoverflow.com/questions/1971183/when-does-c-allocate-deallocate-string-literals
+const char* boolToCstr(bool currentBoolean){
+    return currentBoolean ? "true" : "false";
+}
+
+}
+
+}
+
+}
+
+/**
+ * Copyright (c) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
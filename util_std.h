@@ -0,0 +1,188 @@
+/**
+ * Copyright (C) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * This library is distributed under the MIT License. See notice at the end
+ * of this file.
+ *
+ */
+
+#ifndef UTIL_STD_H
+#define UTIL_STD_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+/**
+  Qt free versions of the Util::FileSystem and Util::String functions (C++17 and POSIX), for programs that don't link QtCore.
+  They work on UTF-8 bytes and have the same semantics as the Qt ones (a code point is a single char for ? in wildcards,
+  the same chars are whitespace...).
+  **/
+namespace Util{
+
+namespace Std{
+
+namespace FileSystem {
+
+std::string normalizePath(std::string_view path);
+void normalizePathInPlace(std::string &path);
+
+std::string cutName(std::string_view path);
+
+std::string cutNameWithoutBackSlash(std::string_view path);
+
+// The name after the last slash as a view into path, without the quotes at its ends
+std::string_view cutNameView(std::string_view path);
+
+std::string normalizeAndQuote(std::string_view path);
+
+enum class CloneMode{
+    Disabled,
+    Reflink, // FICLONE when the filesystem supports it (btrfs, xfs...), full copy otherwise
+    ReflinkOrHardLink // hard link when possible (the destination then shares the source inode), as Reflink otherwise
+};
+
+enum class CopyStrategy{
+    Failed,
+    Reflink,
+    HardLink,
+    FullCopy
+};
+
+struct CopyFileError{
+    std::string sourcePath;
+    std::string destinationPath;
+    std::string errorString;
+};
+
+struct CopyDirOptions{
+    bool isRecursive = false;
+    int maxThreads = 0; // 0 = std::thread::hardware_concurrency()
+    CloneMode cloneMode = CloneMode::Disabled;
+};
+
+struct CopyDirResult{
+    std::int64_t filesCopied = 0;
+    std::int64_t bytesCopied = 0;
+    std::vector<CopyFileError> errors;
+
+    bool success() const { return errors.empty(); }
+};
+
+struct RmDirError{
+    std::string path;
+    std::string errorString;
+};
+
+struct RmDirResult{
+    std::int64_t entriesRemoved = 0;
+    std::vector<RmDirError> errors;
+
+    bool success() const { return errors.empty(); }
+};
+
+// Copies a file, the destination must not exist
+CopyStrategy copyFile(const std::string &sourcePath, const std::string &destinationPath, CloneMode cloneMode = CloneMode::Disabled, std::string *errorString = nullptr);
+
+// Copies fromPath folder into toPath (toPath/<fromPath folder name>), hidden files are skipped like in the Qt version
+// Files are copied while the tree is still being walked, only a bounded number of them wait in memory
+bool copyDir(const std::string &fromPath, const std::string &toPath, bool isRecursive);
+CopyDirResult copyDir(const std::string &fromPath, const std::string &toPath, const CopyDirOptions &options);
+
+// A folder that doesn't exist counts as removed, a symlink to a folder is removed without touching the folder
+bool rmDir(const std::string &dirPath, RmDirResult *result = nullptr);
+
+// Same rules as Util::FileSystem::WildcardMatcher, e.g.:
+// *.xml
+// /myXmls/*.xml
+class WildcardMatcher{
+public:
+    WildcardMatcher();
+    explicit WildcardMatcher(std::string_view wildcard);
+    explicit WildcardMatcher(const std::vector<std::string> &wildcards);
+
+    bool isEmpty() const; // true if there isn't any non empty wildcard
+    bool matches(std::string_view filePath) const;
+    int matchIndex(std::string_view filePath) const; // index of the first matching wildcard, -1 if none
+
+private:
+    void compile(const std::vector<std::string> &wildcards);
+
+    int stateWords = 0;
+    std::vector<std::uint64_t> rows; // for each code point, the positions that can move on when reading it
+    int asciiRows[128];
+    std::unordered_map<std::uint32_t, int> otherRows;
+    std::vector<std::uint64_t> starMask;
+    std::vector<std::uint64_t> initialStates;
+    std::vector<std::uint64_t> acceptStates;
+    std::vector<int> acceptPositions; // for each wildcard (-1 if empty)
+};
+
+std::vector<std::string> filterFilesByWildcard(const std::vector<std::string> &filePaths, std::string_view wildcard);
+std::vector<std::string> filterFilesByWildcard(const std::vector<std::string> &filePaths, const std::vector<std::string> &wildcards);
+std::vector<std::string> filterFilesByWildcard(const std::vector<std::string> &filePaths, const WildcardMatcher &matcher);
+
+enum class HashAlgorithm{
+    Md5,
+    Sha1,
+    Sha256
+};
+
+// Hex digest, empty on failure
+std::string fileHash(const std::string &fileName, HashAlgorithm hashAlgorithm);
+std::string dataHash(std::string_view data, HashAlgorithm hashAlgorithm);
+
+}
+
+namespace String {
+
+std::string insertApostrophes(std::string_view currString);
+
+std::string insertQuotes(std::string_view currString);
+
+// Removes all the whitespace (the Unicode whitespace QChar::isSpace removes, UTF-8 encoded)
+std::string fullTrim(std::string_view str);
+void fullTrimInPlace(std::string &str);
+
+// Each token is a view into the text, an empty separator doesn't split anything
+std::vector<std::string_view> splitView(std::string_view text, std::string_view separator);
+std::vector<std::string> substring(std::string_view myString, std::string_view separator);
+
+std::string normalizeDecimalSeparator(std::string_view value);
+
+const char* boolToCstr(bool currentBoolean);
+
+}
+
+}
+
+}
+
+#endif // UTIL_STD_H
+
+/**
+ * Copyright (c) 2017 - 2018 Fábio Bento (fabiobento512)
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */